@@ -1,17 +1,21 @@
 #include "tests/TestWidget.hpp"
 
 #include <QApplication>
-#include "QFluentWidgets/common/Font.hpp"
+#include "QFluentWidgets/common/Startup.hpp"
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
-    if(!fluent::Font::loadMSFont()) {
+    fluent::StartupPipeline startup;
+    startup.start();
+
+    TestWidget w;
+
+    if(!startup.waitForCritical()) {
         return -1;
     }
 
-    TestWidget w;
     w.show();
     return a.exec();
 }
@@ -0,0 +1,243 @@
+#include "AnimationDriver.hpp"
+
+#include "QFluentWidgets/common/MotionPolicy.hpp"
+#include "QFluentWidgets/common/AnimationQuality.hpp"
+
+#include <QGuiApplication>
+#include <QCoreApplication>
+#include <QScreen>
+#include <QThread>
+#include <QMetaObject>
+
+namespace fluent {
+
+    FluentAnimationDriver::FluentAnimationDriver(QObject* parent)
+        : QAnimationDriver(parent), frameRequested(false), flushQueued(false), ticking(false), frames(0),
+        manualClock(qgetenv("QFLUENT_ANIMATION_CLOCK") == "manual"), manualTime(0), manualStartTime(0), lastTickTime(-1)
+    {
+        wallClock.start();
+
+        fallbackTimer.setSingleShot(true);
+        fallbackTimer.setTimerType(Qt::PreciseTimer);
+        connect(&fallbackTimer, &QTimer::timeout, this, [this] {
+            frameRequested = false;
+            tick();
+        });
+    }
+
+
+    void FluentAnimationDriver::advance() {
+        ticking = true;
+        advanceAnimation();
+        ticking = false;
+        ++frames;
+        flushUpdates();
+    }
+
+
+    void FluentAnimationDriver::scheduleUpdate(QWidget* widget, const QRect& rect) {
+        if (!widget || !widget->isVisible()) {
+            return;
+        }
+
+        QWidget* top = widget->window();
+        QRect area = rect.isNull() ? widget->rect() : rect;
+        if (top != widget) {
+            area.moveTopLeft(widget->mapTo(top, area.topLeft()));
+        }
+
+        auto& entry = dirtyRegions[top];
+        entry.first = top;
+        entry.second += area;
+
+        // Updates outside of a tick still get coalesced until the event loop
+        if (!ticking && !flushQueued) {
+            flushQueued = true;
+            QMetaObject::invokeMethod(this, &FluentAnimationDriver::flushUpdates, Qt::QueuedConnection);
+        }
+    }
+
+
+    int FluentAnimationDriver::frameInterval() const {
+        QScreen* screen = window ? window->screen() : QGuiApplication::primaryScreen();
+        qreal rate = screen ? screen->refreshRate() : 60;
+        return rate > 1 ? qMax(1, qRound(1000 / rate)) : 16;
+    }
+
+
+    void FluentAnimationDriver::setManualClock(bool enabled) {
+        if (manualClock == enabled) {
+            return;
+        }
+
+        manualClock = enabled;
+        manualStartTime = manualTime;
+        fallbackTimer.stop();
+        frameRequested = false;
+
+        if (!manualClock && isRunning()) {
+            requestFrame();
+        }
+    }
+
+
+    void FluentAnimationDriver::advanceBy(int msecs) {
+        Q_ASSERT(manualClock);
+        manualTime += qMax(0, msecs);
+
+        if (isRunning()) {
+            advance();
+        }
+        else {
+            flushUpdates();
+        }
+    }
+
+
+    qint64 FluentAnimationDriver::now() const {
+        return manualClock ? manualTime : wallClock.elapsed();
+    }
+
+
+    qint64 FluentAnimationDriver::elapsed() const {
+        if (manualClock) {
+            return manualTime - manualStartTime;
+        }
+        return QAnimationDriver::elapsed();
+    }
+
+
+    void FluentAnimationDriver::start() {
+        manualStartTime = manualTime;
+        lastTickTime = -1;
+        QAnimationDriver::start();
+        requestFrame();
+    }
+
+
+    void FluentAnimationDriver::stop() {
+        fallbackTimer.stop();
+        frameRequested = false;
+        QAnimationDriver::stop();
+    }
+
+
+    bool FluentAnimationDriver::eventFilter(QObject* watched, QEvent* event) {
+        // Advance right before the window paints, so the new values and the
+        // repaint land in the same frame
+        if (watched == window && event->type() == QEvent::UpdateRequest && frameRequested
+            && motionPolicy()->mode() != MotionPolicy::Mode::ReducedFrameRate) {
+            frameRequested = false;
+            fallbackTimer.stop();
+            tick();
+        }
+        return QAnimationDriver::eventFilter(watched, event);
+    }
+
+
+    QWindow* FluentAnimationDriver::paceWindow() {
+        QWindow* candidate = QGuiApplication::focusWindow();
+        if (!candidate || !candidate->isExposed()) {
+            candidate = nullptr;
+            for (auto* top : QGuiApplication::topLevelWindows()) {
+                if (top->isExposed()) {
+                    candidate = top;
+                    break;
+                }
+            }
+        }
+
+        if (candidate != window) {
+            if (window) {
+                window->removeEventFilter(this);
+            }
+            window = candidate;
+            if (window) {
+                window->installEventFilter(this);
+            }
+        }
+        return window;
+    }
+
+
+    void FluentAnimationDriver::requestFrame() {
+        if (frameRequested || manualClock) {
+            return;
+        }
+        frameRequested = true;
+
+        if (motionPolicy()->mode() == MotionPolicy::Mode::ReducedFrameRate) {
+            fallbackTimer.start(motionPolicy()->reducedFrameInterval());
+        }
+        else if (auto* top = paceWindow()) {
+            top->requestUpdate();
+            fallbackTimer.start(2 * frameInterval());
+        }
+        else {
+            fallbackTimer.start(frameInterval());
+        }
+    }
+
+
+    void FluentAnimationDriver::tick() {
+        if (!isRunning()) {
+            return;
+        }
+
+        qint64 now = wallClock.elapsed();
+        if (lastTickTime >= 0 && motionPolicy()->mode() == MotionPolicy::Mode::Full) {
+            motionPolicy()->reportFrameInterval(now - lastTickTime, frameInterval());
+            animationQuality()->reportFrameInterval(now - lastTickTime, frameInterval());
+        }
+        lastTickTime = now;
+
+        advance();
+        if (isRunning()) {
+            requestFrame();
+        }
+    }
+
+
+    void FluentAnimationDriver::flushUpdates() {
+        flushQueued = false;
+        if (dirtyRegions.isEmpty()) {
+            return;
+        }
+
+        auto regions = std::move(dirtyRegions);
+        dirtyRegions.clear();
+
+        for (const auto& entry : regions) {
+            if (entry.first) {
+                entry.first->update(entry.second);
+            }
+        }
+    }
+
+
+    AnimationTicker::AnimationTicker(std::function<void(int)> callback, QObject* parent)
+        : QAbstractAnimation(parent), callback(std::move(callback))
+    {
+        animationDriver();
+    }
+
+
+    void AnimationTicker::updateCurrentTime(int currentTime) {
+        callback(currentTime);
+    }
+
+
+
+    FluentAnimationDriver* animationDriver() {
+        Q_ASSERT(QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread());
+
+        // Owned by the application so it uninstalls while the unified timer still exists
+        static QPointer<FluentAnimationDriver> driver;
+        if (!driver) {
+            driver = new FluentAnimationDriver(QCoreApplication::instance());
+            driver->install();
+        }
+        return driver;
+    }
+
+}
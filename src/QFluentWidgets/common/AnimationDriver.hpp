@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QAnimationDriver>
+#include <QObject>
+#include <QPointer>
+#include <QWidget>
+#include <QWindow>
+#include <QRegion>
+#include <QHash>
+#include <QTimer>
+#include <QEvent>
+#include <QElapsedTimer>
+#include <QAbstractAnimation>
+#include <functional>
+
+namespace fluent {
+
+    // Drives every QAbstractAnimation of the GUI thread from the frame
+    // callbacks of a top-level window (QWindow::requestUpdate), so all Fluent
+    // animations advance in one tick per frame. A timer takes over while no
+    // window delivers frames, e.g. when everything is hidden or minimized.
+    //
+    // With the manual clock (setManualClock() or QFLUENT_ANIMATION_CLOCK=manual)
+    // time only moves through advanceBy(), which makes animations frame-exact
+    // and instant in tests and benchmarks.
+    //
+    // The pacing follows motionPolicy(): in reduced frame rate mode the timer
+    // paces every tick at the policy's rate instead of the window.
+    class FluentAnimationDriver : public QAnimationDriver
+    {
+        Q_OBJECT
+
+    public:
+        explicit FluentAnimationDriver(QObject* parent = nullptr);
+
+        void advance() override;
+
+        // Collects the repaint of an animated widget, flushed as a single
+        // update() per top-level window after the tick
+        void scheduleUpdate(QWidget* widget, const QRect& rect = QRect());
+
+        int frameInterval() const;
+        qint64 frameCount() const { return frames; }
+
+        // Switch while no animation is running, the time base changes
+        void setManualClock(bool enabled);
+        bool isManualClock() const { return manualClock; }
+        void advanceBy(int msecs);
+
+        // Monotonic time in ms on the driver's clock, for code that timestamps input
+        qint64 now() const;
+
+        qint64 elapsed() const override;
+
+    protected:
+        void start() override;
+        void stop() override;
+        bool eventFilter(QObject* watched, QEvent* event) override;
+
+    private:
+        QPointer<QWindow> window;
+        QTimer fallbackTimer;
+        QElapsedTimer wallClock;
+        QHash<QWidget*, QPair<QPointer<QWidget>, QRegion>> dirtyRegions;
+        bool frameRequested;
+        bool flushQueued;
+        bool ticking;
+        qint64 frames;
+        bool manualClock;
+        qint64 manualTime;
+        qint64 manualStartTime;
+        qint64 lastTickTime;
+
+        QWindow* paceWindow();
+        void requestFrame();
+        void tick();
+        void flushUpdates();
+    };
+
+
+    // Endless animation calling back with its current time on every driver
+    // tick, for per-frame work that is not a property interpolation
+    class AnimationTicker : public QAbstractAnimation
+    {
+    public:
+        explicit AnimationTicker(std::function<void(int)> callback, QObject* parent = nullptr);
+
+        int duration() const override { return -1; }
+
+    protected:
+        void updateCurrentTime(int currentTime) override;
+
+    private:
+        std::function<void(int)> callback;
+    };
+
+
+    // Installed on first use, must be called on the GUI thread
+    FluentAnimationDriver* animationDriver();
+
+}
@@ -0,0 +1,173 @@
+#include "AnimationLayer.hpp"
+
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+
+#include <QPainter>
+#include <QTransform>
+
+namespace fluent {
+
+    WidgetAnimationLayer::WidgetAnimationLayer(QWidget* target)
+        : QWidget(target->parentWidget()), target(target), active(false),
+        m_position(target->pos()), m_scale(1.0f), m_angle(0.0f), m_opacity(1.0f)
+    {
+        setAttribute(Qt::WA_TransparentForMouseEvents);
+        setAttribute(Qt::WA_NoSystemBackground);
+        setFocusPolicy(Qt::NoFocus);
+        hide();
+    }
+
+
+    bool WidgetAnimationLayer::begin() {
+        if (active) {
+            return true;
+        }
+
+        // The layer lives in the target's parent, top-level windows have none
+        if (!target || !parentWidget()) {
+            return false;
+        }
+
+        snapshot = target->grab();
+        m_position = target->pos();
+        m_scale = 1.0f;
+        m_angle = 0.0f;
+        m_opacity = 1.0f;
+        paintedRect = QRect();
+
+        setGeometry(parentWidget()->rect());
+        raise();
+        show();
+        target->hide();
+
+        active = true;
+        invalidate();
+        return true;
+    }
+
+
+    void WidgetAnimationLayer::end() {
+        if (!active) {
+            return;
+        }
+        active = false;
+
+        for (auto& ani : animations) {
+            if (ani) {
+                ani->stop();
+                ani->deleteLater();
+            }
+        }
+        animations.clear();
+
+        if (target) {
+            target->move(m_position);
+            if (m_opacity > 0) {
+                target->show();
+            }
+        }
+
+        hide();
+        snapshot = QPixmap();
+        emit finished();
+    }
+
+
+    FluentAnimation* WidgetAnimationLayer::animate(
+        FluentAnimationProperty propertyType,
+        const QVariant& endValue,
+        FluentAnimationType aniType,
+        FluentAnimationSpeed speed
+    ) {
+        if (!begin()) {
+            return nullptr;
+        }
+
+        auto* ani = new FluentAnimation(this, aniType);
+        ani->setSpeed(speed);
+        ani->setTargetObject(this);
+        ani->setPropertyName(getString(propertyType));
+        connect(ani, &QAbstractAnimation::finished, this, &WidgetAnimationLayer::onAnimationFinished);
+
+        animations.append(ani);
+        ani->startAnimation(endValue, property(getString(propertyType)));
+        return ani;
+    }
+
+
+    void WidgetAnimationLayer::setPosition(const QPoint& position) {
+        m_position = position;
+        invalidate();
+    }
+
+
+    void WidgetAnimationLayer::setScale(float scale) {
+        m_scale = scale;
+        invalidate();
+    }
+
+
+    void WidgetAnimationLayer::setAngle(float angle) {
+        m_angle = angle;
+        invalidate();
+    }
+
+
+    void WidgetAnimationLayer::setOpacity(float opacity) {
+        m_opacity = opacity;
+        invalidate();
+    }
+
+
+    void WidgetAnimationLayer::paintEvent(QPaintEvent* e) {
+        if (!active || snapshot.isNull() || m_opacity <= 0) {
+            return;
+        }
+
+        QSizeF size = snapshot.deviceIndependentSize();
+        QPointF center = QPointF(m_position) + QPointF(size.width(), size.height()) / 2;
+
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, !qFuzzyCompare(m_scale, 1.0f) || !qFuzzyIsNull(m_angle));
+        painter.setOpacity(m_opacity);
+        painter.translate(center);
+        painter.rotate(m_angle);
+        painter.scale(m_scale, m_scale);
+        painter.drawPixmap(QPointF(-size.width() / 2, -size.height() / 2), snapshot);
+    }
+
+
+    QRect WidgetAnimationLayer::snapshotRect() const {
+        QSizeF size = snapshot.deviceIndependentSize();
+        QRectF rect(-size.width() / 2, -size.height() / 2, size.width(), size.height());
+
+        QTransform transform;
+        transform.translate(m_position.x() + size.width() / 2, m_position.y() + size.height() / 2);
+        transform.rotate(m_angle);
+        transform.scale(m_scale, m_scale);
+        return transform.mapRect(rect).toAlignedRect().adjusted(-1, -1, 1, 1);
+    }
+
+
+    void WidgetAnimationLayer::invalidate() {
+        if (!active) {
+            return;
+        }
+
+        // Only the area the snapshot left and the one it moved to
+        QRect rect = snapshotRect();
+        animationDriver()->scheduleUpdate(this, rect.united(paintedRect));
+        paintedRect = rect;
+    }
+
+
+    void WidgetAnimationLayer::onAnimationFinished() {
+        for (auto& ani : animations) {
+            if (ani && ani->state() == QAbstractAnimation::Running) {
+                return;
+            }
+        }
+        end();
+    }
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QWidget>
+#include <QPixmap>
+#include <QPointer>
+#include <QPoint>
+#include <QList>
+#include <QVariant>
+
+#include "QFluentWidgets/common/Animations.hpp"
+
+namespace fluent {
+
+    // Animates a snapshot of a widget instead of the widget itself. begin()
+    // grabs the target into a pixmap at its device pixel ratio and hides it,
+    // the layer then blits that pixmap with the animated position, scale,
+    // angle and opacity, and end() swaps the live widget back in.
+    class WidgetAnimationLayer : public QWidget
+    {
+        Q_OBJECT
+        Q_PROPERTY(QPoint position READ position WRITE setPosition)
+        Q_PROPERTY(float scale READ scale WRITE setScale)
+        Q_PROPERTY(float angle READ angle WRITE setAngle)
+        Q_PROPERTY(float opacity READ opacity WRITE setOpacity)
+
+    public:
+        explicit WidgetAnimationLayer(QWidget* target);
+
+        bool begin();
+        void end();
+        bool isActive() const { return active; }
+
+        // Starts animating a property of the snapshot, begin() is called if
+        // needed and end() once every animation of the layer has finished
+        FluentAnimation* animate(FluentAnimationProperty propertyType, const QVariant& endValue,
+            FluentAnimationType aniType = FluentAnimationType::POINT_TO_POINT,
+            FluentAnimationSpeed speed = FluentAnimationSpeed::MEDIUM);
+
+        QPoint position() const { return m_position; }
+        void setPosition(const QPoint& position);
+
+        float scale() const { return m_scale; }
+        void setScale(float scale);
+
+        float angle() const { return m_angle; }
+        void setAngle(float angle);
+
+        float opacity() const { return m_opacity; }
+        void setOpacity(float opacity);
+
+    signals:
+        void finished();
+
+    protected:
+        void paintEvent(QPaintEvent* e) override;
+
+    private:
+        QPointer<QWidget> target;
+        QPixmap snapshot;
+        QList<QPointer<FluentAnimation>> animations;
+        QRect paintedRect;
+        bool active;
+
+        QPoint m_position;
+        float m_scale;
+        float m_angle;
+        float m_opacity;
+
+        QRect snapshotRect() const;
+        void invalidate();
+        void onAnimationFinished();
+    };
+
+}
@@ -0,0 +1,149 @@
+#include "AnimationPool.hpp"
+
+#include <QCoreApplication>
+#include <QMetaMethod>
+#include <QPointer>
+
+namespace fluent {
+
+    // Drops every connection of obj's signals except destroyed(), which keeps
+    // the books of the pool and the profiler
+    static void disconnectReceivers(QObject* obj) {
+        const QMetaObject* meta = obj->metaObject();
+        for (int i = 0; i < meta->methodCount(); ++i) {
+            QMetaMethod method = meta->method(i);
+            if (method.methodType() == QMetaMethod::Signal && method.name() != "destroyed") {
+                QObject::disconnect(obj, method, nullptr, QMetaMethod());
+            }
+        }
+    }
+
+
+    AnimationPool::AnimationPool(QObject* parent)
+        : QObject(parent), maxPooled(32), created(0), reused(0)
+    {}
+
+
+    void AnimationPool::release(FluentAnimation* ani) {
+        auto it = live.find(ani);
+        if (it == live.end()) {
+            return;
+        }
+
+        const QMetaObject* targetType = it.value();
+        live.erase(it);
+
+        ani->stop();
+        disconnectReceivers(ani);
+        if (ani->targetObject()) {
+            disconnectReceivers(ani->targetObject());
+        }
+
+        auto& list = pooled[targetType];
+        if (list.size() >= maxPooled) {
+            ani->deleteLater();
+            return;
+        }
+
+        ani->setParent(this);
+        list.append(ani);
+    }
+
+
+    void AnimationPool::setMaxPooledPerType(int count) {
+        maxPooled = qMax(0, count);
+        for (auto& list : pooled) {
+            while (list.size() > maxPooled) {
+                delete list.takeLast();
+            }
+        }
+    }
+
+
+    AnimationPoolStats AnimationPool::stats() const {
+        AnimationPoolStats stats;
+        stats.liveAnimations = live.size();
+        for (const auto& list : pooled) {
+            stats.pooledAnimations += list.size();
+        }
+        stats.created = created;
+        stats.reused = reused;
+        return stats;
+    }
+
+
+    void AnimationPool::clear() {
+        for (auto& list : pooled) {
+            qDeleteAll(list);
+        }
+        pooled.clear();
+    }
+
+
+    FluentAnimation* AnimationPool::take(const QMetaObject* targetType) {
+        auto it = pooled.find(targetType);
+        if (it == pooled.end() || it->isEmpty()) {
+            return nullptr;
+        }
+
+        FluentAnimation* ani = it->takeLast();
+        live.insert(ani, targetType);
+        ++reused;
+        return ani;
+    }
+
+
+    void AnimationPool::adopt(FluentAnimation* ani, const QMetaObject* targetType) {
+        live.insert(ani, targetType);
+        ++created;
+
+        // A live animation deleted with its parent leaves the books
+        connect(ani, &QObject::destroyed, this, [this, ani] {
+            live.remove(ani);
+        });
+    }
+
+
+    FluentAnimation* AnimationPool::setup(
+        FluentAnimation* ani,
+        FluentAnimationType aniType,
+        FluentAnimationProperty propertyType,
+        FluentAnimationSpeed speed,
+        const QVariant& value,
+        QWidget* parent,
+        bool autoRelease
+    ) {
+        if (ani->parent() != parent) {
+            ani->setParent(parent);
+        }
+
+        // A reused animation carries the settings of its previous owner,
+        // the type sets the curve and the speed the duration
+        ani->setAnimationType(aniType);
+        ani->setSpeed(speed);
+        ani->setDirection(QAbstractAnimation::Forward);
+        ani->setLoopCount(1);
+        ani->setKeyValues(QVariantAnimation::KeyValues());
+        ani->setRole(AnimationRole::Decorative);
+        ani->setPropertyName(getString(propertyType));
+
+        if (value.isValid()) {
+            ani->setValue(value);
+        }
+
+        if (autoRelease) {
+            connect(ani, &QAbstractAnimation::finished, this, [this, ani] { release(ani); });
+        }
+        return ani;
+    }
+
+
+    AnimationPool* animationPool() {
+        static QPointer<AnimationPool> pool;
+        if (!pool) {
+            pool = new AnimationPool(QCoreApplication::instance());
+        }
+        return pool;
+    }
+
+}
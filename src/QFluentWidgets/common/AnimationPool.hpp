@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QVariant>
+#include <QMetaObject>
+
+#include "QFluentWidgets/common/Animations.hpp"
+
+namespace fluent {
+
+    struct AnimationPoolStats {
+        int liveAnimations = 0;
+        int pooledAnimations = 0;
+        qint64 created = 0;
+        qint64 reused = 0;
+    };
+
+
+    // Recycles FluentAnimations together with their target object, which is
+    // a child of the animation. A live animation belongs to the parent given
+    // to acquire(), a released one to the pool until it is reused or trimmed.
+    class AnimationPool : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit AnimationPool(QObject* parent = nullptr);
+
+        // Same arguments as FluentAnimation::create, with autoRelease the
+        // animation returns to the pool when it finishes
+        template <typename T>
+        FluentAnimation* acquire(FluentAnimationType aniType, FluentAnimationProperty propertyType,
+            FluentAnimationSpeed speed = FluentAnimationSpeed::FAST, const QVariant& value = QVariant(),
+            QWidget* parent = nullptr, bool autoRelease = false) {
+            FluentAnimation* ani = take(&T::staticMetaObject);
+            if (!ani) {
+                ani = new FluentAnimation(parent, aniType);
+                ani->setTargetObject(new T(ani));
+                adopt(ani, &T::staticMetaObject);
+            }
+            return setup(ani, aniType, propertyType, speed, value, parent, autoRelease);
+        }
+
+        void release(FluentAnimation* ani);
+
+        int maxPooledPerType() const { return maxPooled; }
+        void setMaxPooledPerType(int count);
+
+        AnimationPoolStats stats() const;
+        void clear();
+
+    private:
+        QHash<const QMetaObject*, QList<FluentAnimation*>> pooled;
+        QHash<FluentAnimation*, const QMetaObject*> live;
+        int maxPooled;
+        qint64 created;
+        qint64 reused;
+
+        FluentAnimation* take(const QMetaObject* targetType);
+        void adopt(FluentAnimation* ani, const QMetaObject* targetType);
+        FluentAnimation* setup(FluentAnimation* ani, FluentAnimationType aniType, FluentAnimationProperty propertyType,
+            FluentAnimationSpeed speed, const QVariant& value, QWidget* parent, bool autoRelease);
+    };
+
+
+    // Owned by the application, must be used on the GUI thread
+    AnimationPool* animationPool();
+
+}
@@ -0,0 +1,307 @@
+#include "AnimationProfiler.hpp"
+
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+
+#include <QPainter>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QPaintEvent>
+
+namespace fluent {
+
+    Q_GLOBAL_STATIC(AnimationProfiler, globalAnimationProfiler);
+
+
+    static const int MaxRetiredStats = 64;
+
+
+    static QString describe(const QObject* obj) {
+        if (!obj) {
+            return QString();
+        }
+        QString name = obj->metaObject()->className();
+        return obj->objectName().isEmpty() ? name : QString("%1(%2)").arg(name, obj->objectName());
+    }
+
+
+    AnimationProfiler::AnimationProfiler(QObject* parent)
+        : QObject(parent),
+        enabled(qEnvironmentVariableIsSet("QFLUENT_ANIMATION_PROFILE") || qEnvironmentVariableIsSet("QFLUENT_ANIMATION_HUD")),
+        hudEnabled(qEnvironmentVariableIsSet("QFLUENT_ANIMATION_HUD"))
+    {
+        clock.start();
+    }
+
+
+    void AnimationProfiler::setEnabled(bool enabled) {
+        this->enabled = enabled;
+    }
+
+
+    void AnimationProfiler::setHudEnabled(bool enabled) {
+        hudEnabled = enabled;
+        if (enabled) {
+            this->enabled = true;
+        }
+    }
+
+
+    QList<AnimationStats> AnimationProfiler::stats() const {
+        QList<AnimationStats> result = retired;
+        qint64 frame = animationDriver()->frameInterval();
+
+        for (const auto& record : records) {
+            AnimationStats stats = record.stats;
+            if (stats.running) {
+                stats.expectedTicks += (clock.elapsed() - record.runStart) / frame;
+            }
+            result.append(stats);
+        }
+        return result;
+    }
+
+
+    QString AnimationProfiler::report() const {
+        QString text = "Animation frame times:";
+        for (const auto& stats : this->stats()) {
+            text += QString("\n  %1 on %2: %3 runs, %4/%5 ticks, %6 dropped, max interval %7 ms, frame avg %8 ms max %9 ms")
+                .arg(stats.name, stats.widget)
+                .arg(stats.runs)
+                .arg(stats.ticks)
+                .arg(stats.expectedTicks)
+                .arg(stats.droppedFrames)
+                .arg(stats.maxTickInterval)
+                .arg(stats.frames ? stats.frameTimeUs / 1000.0 / stats.frames : 0, 0, 'f', 2)
+                .arg(stats.maxFrameTimeUs / 1000.0, 0, 'f', 2);
+        }
+        return text;
+    }
+
+
+    void AnimationProfiler::reset() {
+        retired.clear();
+        for (auto& record : records) {
+            bool running = record.stats.running;
+            record.stats = AnimationStats { record.stats.name, record.stats.widget };
+            record.stats.running = running;
+            record.runStart = clock.elapsed();
+        }
+    }
+
+
+    void AnimationProfiler::stateChanged(QAbstractAnimation* ani, QObject* target, QAbstractAnimation::State newState) {
+        if (!enabled) {
+            return;
+        }
+
+        QWidget* widget = nullptr;
+        for (QObject* obj = target; obj && !widget; obj = obj->parent()) {
+            widget = qobject_cast<QWidget*>(obj);
+        }
+
+        auto it = records.find(ani);
+        if (it == records.end()) {
+            it = records.insert(ani, Record());
+            it->stats.name = describe(ani);
+
+            connect(ani, &QObject::destroyed, this, [this, ani] {
+                auto it = records.find(ani);
+                if (it == records.end()) {
+                    return;
+                }
+                finishRun(*it);
+                framePaints.remove(ani);
+                retired.append(it->stats);
+                if (retired.size() > MaxRetiredStats) {
+                    retired.removeFirst();
+                }
+                records.erase(it);
+            });
+        }
+
+        Record& record = *it;
+        if (newState != QAbstractAnimation::Running) {
+            finishRun(record);
+            return;
+        }
+
+        record.widget = widget;
+        record.stats.widget = describe(widget);
+        record.stats.runs += 1;
+        record.stats.running = true;
+        record.runStart = clock.elapsed();
+        record.lastTick = -1;
+
+        if (widget) {
+            watch(widget);
+
+            QWidget* top = widget->window();
+            if (hudEnabled && top != widget && !top->findChild<AnimationHud*>(QString(), Qt::FindDirectChildrenOnly)) {
+                new AnimationHud(top);
+            }
+        }
+    }
+
+
+    void AnimationProfiler::ticked(QAbstractAnimation* ani) {
+        if (!enabled) {
+            return;
+        }
+
+        auto it = records.find(ani);
+        if (it == records.end() || !it->stats.running) {
+            return;
+        }
+
+        qint64 now = clock.elapsed();
+        if (it->lastTick >= 0) {
+            qint64 interval = now - it->lastTick;
+            qint64 frame = animationDriver()->frameInterval();
+
+            it->stats.maxTickInterval = qMax(it->stats.maxTickInterval, interval);
+            if (2 * interval > 3 * frame) {
+                it->stats.droppedFrames += qMax<qint64>(1, qRound(qreal(interval) / frame) - 1);
+            }
+        }
+        it->stats.ticks += 1;
+        it->lastTick = now;
+    }
+
+
+    bool AnimationProfiler::eventFilter(QObject* obj, QEvent* e) {
+        if (!enabled || e->type() != QEvent::Paint) {
+            return QObject::eventFilter(obj, e);
+        }
+
+        bool animated = false;
+        for (auto it = records.begin(); it != records.end(); ++it) {
+            if (it->stats.running && it->widget == obj) {
+                framePaints.insert(it.key());
+                animated = true;
+            }
+        }
+
+        // The paint is delivered normally, the frame is timed from the first
+        // animated paint to the end of the update that triggered it
+        if (animated && !framePending) {
+            framePending = true;
+            frameTimer.start();
+            QMetaObject::invokeMethod(this, &AnimationProfiler::finishFrame, Qt::QueuedConnection);
+        }
+        return QObject::eventFilter(obj, e);
+    }
+
+
+    void AnimationProfiler::finishFrame() {
+        qint64 elapsed = frameTimer.nsecsElapsed() / 1000;
+        framePending = false;
+
+        for (auto* ani : std::as_const(framePaints)) {
+            auto it = records.find(ani);
+            if (it == records.end()) {
+                continue;
+            }
+            it->stats.frames += 1;
+            it->stats.frameTimeUs += elapsed;
+            it->stats.maxFrameTimeUs = qMax(it->stats.maxFrameTimeUs, elapsed);
+        }
+        framePaints.clear();
+    }
+
+
+    void AnimationProfiler::finishRun(Record& record) {
+        if (!record.stats.running) {
+            return;
+        }
+        record.stats.running = false;
+        record.stats.expectedTicks += qMax<qint64>(1, (clock.elapsed() - record.runStart) / animationDriver()->frameInterval());
+    }
+
+
+    void AnimationProfiler::watch(QWidget* widget) {
+        if (watchedWidgets.contains(widget)) {
+            return;
+        }
+
+        watchedWidgets.insert(widget);
+        widget->installEventFilter(this);
+        connect(widget, &QObject::destroyed, this, [this, widget] {
+            watchedWidgets.remove(widget);
+        });
+    }
+
+
+    AnimationProfiler* animationProfiler() {
+        return globalAnimationProfiler();
+    }
+
+
+
+    AnimationHud::AnimationHud(QWidget* window)
+        : QWidget(window)
+    {
+        setAttribute(Qt::WA_TransparentForMouseEvents);
+        setFocusPolicy(Qt::NoFocus);
+        setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+        window->installEventFilter(this);
+        connect(&refreshTimer, &QTimer::timeout, this, &AnimationHud::refresh);
+        refreshTimer.start(500);
+
+        refresh();
+        show();
+    }
+
+
+    void AnimationHud::refresh() {
+        lines.clear();
+        lines << QString("%1 ticks @ %2 ms").arg(animationDriver()->frameCount()).arg(animationDriver()->frameInterval());
+        for (const auto& item : animationProfiler()->stats()) {
+            lines << QString("%1%2  %3/%4  drop %5  frame %6 ms")
+                .arg(item.running ? "* " : "  ")
+                .arg(item.widget.isEmpty() ? item.name : item.widget)
+                .arg(item.ticks)
+                .arg(item.expectedTicks)
+                .arg(item.droppedFrames)
+                .arg(item.frames ? item.frameTimeUs / 1000.0 / item.frames : 0, 0, 'f', 2);
+        }
+
+        // Only the box is repainted, the window below stays untouched
+        QFontMetrics metrics(font());
+        int width = 0;
+        for (const auto& line : lines) {
+            width = qMax(width, metrics.horizontalAdvance(line));
+        }
+
+        QSize size(width + 16, lines.size() * metrics.height() + 12);
+        setGeometry(QRect(QPoint(parentWidget()->width() - size.width() - 8, 8), size));
+        raise();
+        update();
+    }
+
+
+    void AnimationHud::paintEvent(QPaintEvent* e) {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(0, 0, 0, 160));
+        painter.drawRoundedRect(rect(), 6, 6);
+
+        QFontMetrics metrics(font());
+        painter.setPen(Qt::white);
+        int y = 6 + metrics.ascent();
+        for (const auto& line : lines) {
+            painter.drawText(8, y, line);
+            y += metrics.height();
+        }
+    }
+
+
+    bool AnimationHud::eventFilter(QObject* obj, QEvent* e) {
+        if (obj == parent() && e->type() == QEvent::Resize) {
+            refresh();
+        }
+        return QWidget::eventFilter(obj, e);
+    }
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <QObject>
+#include <QWidget>
+#include <QPointer>
+#include <QAbstractAnimation>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QTimer>
+#include <QEvent>
+#include <QStringList>
+
+namespace fluent {
+
+    struct AnimationStats {
+        QString name;
+        QString widget;
+        int runs = 0;
+        bool running = false;
+        qint64 ticks = 0;
+        qint64 expectedTicks = 0;
+        qint64 droppedFrames = 0;
+        qint64 maxTickInterval = 0;
+        qint64 frames = 0;
+        qint64 frameTimeUs = 0;
+        qint64 maxFrameTimeUs = 0;
+    };
+
+
+    // Frame-time instrumentation of the Fluent animations: ticks delivered
+    // against the ticks the display rate allows, dropped frames and the time
+    // of the frames that repaint the animated widgets, charged in full to each
+    // animation painted in that frame. Off unless enabled, or unless
+    // QFLUENT_ANIMATION_PROFILE or QFLUENT_ANIMATION_HUD is set; the latter
+    // also shows an AnimationHud on each animated top-level window.
+    class AnimationProfiler : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit AnimationProfiler(QObject* parent = nullptr);
+
+        bool isEnabled() const { return enabled; }
+        void setEnabled(bool enabled);
+
+        bool isHudEnabled() const { return hudEnabled; }
+        void setHudEnabled(bool enabled);
+
+        QList<AnimationStats> stats() const;
+        QString report() const;
+        void reset();
+
+        // Hooks called by the animation classes, the animated widget is the
+        // target or its closest widget ancestor
+        void stateChanged(QAbstractAnimation* ani, QObject* target, QAbstractAnimation::State newState);
+        void ticked(QAbstractAnimation* ani);
+
+    protected:
+        bool eventFilter(QObject* obj, QEvent* e) override;
+
+    private:
+        struct Record {
+            AnimationStats stats;
+            QPointer<QWidget> widget;
+            qint64 runStart = 0;
+            qint64 lastTick = -1;
+        };
+
+        bool enabled;
+        bool hudEnabled;
+        QElapsedTimer clock;
+        QHash<QAbstractAnimation*, Record> records;
+        QList<AnimationStats> retired;
+        QSet<QWidget*> watchedWidgets;
+        QSet<QAbstractAnimation*> framePaints;
+        QElapsedTimer frameTimer;
+        bool framePending = false;
+
+        void finishRun(Record& record);
+        void finishFrame();
+        void watch(QWidget* widget);
+    };
+
+
+    AnimationProfiler* animationProfiler();
+
+
+    // Translucent overlay listing the profiler stats on a top-level window
+    class AnimationHud : public QWidget
+    {
+        Q_OBJECT
+
+    public:
+        explicit AnimationHud(QWidget* window);
+
+    protected:
+        void paintEvent(QPaintEvent* e) override;
+        bool eventFilter(QObject* obj, QEvent* e) override;
+
+    private:
+        QTimer refreshTimer;
+        QStringList lines;
+
+        void refresh();
+    };
+
+}
@@ -0,0 +1,104 @@
+#include "AnimationQuality.hpp"
+
+namespace fluent {
+
+    Q_GLOBAL_STATIC(AnimationQualityScheduler, globalAnimationQuality);
+
+
+    // Degrade after a short run of slow frames, recover only after a long
+    // run of good ones so the levels do not flap
+    static const int DegradeAfterFrames = 10;
+    static const int RestoreAfterFrames = 120;
+
+
+    AnimationQualityScheduler::AnimationQualityScheduler(QObject* parent)
+        : QObject(parent), enabled(qgetenv("QFLUENT_ANIMATION_QUALITY").toLower() != "off"),
+        m_level(Full), budget(0), overBudgetFrames(0), withinBudgetFrames(0)
+    {}
+
+
+    void AnimationQualityScheduler::setEnabled(bool enabled) {
+        this->enabled = enabled;
+        if (!enabled) {
+            setLevel(Full);
+        }
+    }
+
+
+    void AnimationQualityScheduler::setLevel(Level level) {
+        if (m_level == level) {
+            return;
+        }
+
+        Level previous = m_level;
+        m_level = level;
+        overBudgetFrames = 0;
+        withinBudgetFrames = 0;
+
+        static const AnimationRole roles[] = { AnimationRole::Shadow, AnimationRole::ColorTransition, AnimationRole::Decorative };
+        for (int i = 1; i <= ThrottledDecorations; ++i) {
+            bool before = previous >= i;
+            bool after = level >= i;
+            if (before != after) {
+                emit roleDegraded(roles[i - 1], after);
+            }
+        }
+        emit levelChanged(level);
+    }
+
+
+    void AnimationQualityScheduler::setFrameBudget(int msecs) {
+        budget = qMax(0, msecs);
+    }
+
+
+    bool AnimationQualityScheduler::isInstant(AnimationRole role) const {
+        switch (role) {
+        case AnimationRole::Shadow:          return m_level >= StaticShadows;
+        case AnimationRole::ColorTransition: return m_level >= InstantColors;
+        default:                             return false;
+        }
+    }
+
+
+    bool AnimationQualityScheduler::isThrottled(AnimationRole role) const {
+        return role == AnimationRole::Decorative && m_level >= ThrottledDecorations;
+    }
+
+
+    bool AnimationQualityScheduler::skipTick(AnimationRole role, int currentTime, int& lastApplied, int duration) const {
+        bool last = duration >= 0 && currentTime >= duration;
+        if (!isThrottled(role) || last || currentTime < lastApplied || currentTime - lastApplied >= throttledInterval()) {
+            lastApplied = currentTime;
+            return false;
+        }
+        return true;
+    }
+
+
+    void AnimationQualityScheduler::reportFrameInterval(qint64 interval, int expected) {
+        if (!enabled) {
+            return;
+        }
+
+        int frame = budget > 0 ? budget : expected;
+        if (2 * interval > 3 * frame) {
+            withinBudgetFrames = 0;
+            if (++overBudgetFrames >= DegradeAfterFrames && m_level < ThrottledDecorations) {
+                setLevel(Level(m_level + 1));
+            }
+        }
+        else if (5 * interval <= 6 * frame) {
+            overBudgetFrames = 0;
+            if (++withinBudgetFrames >= RestoreAfterFrames && m_level > Full) {
+                setLevel(Level(m_level - 1));
+            }
+        }
+    }
+
+
+    AnimationQualityScheduler* animationQuality() {
+        return globalAnimationQuality();
+    }
+
+}
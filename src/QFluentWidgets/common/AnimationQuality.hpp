@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QObject>
+
+namespace fluent {
+
+    // What an animation is for, decides what the quality scheduler may degrade
+    enum class AnimationRole {
+        Scroll,
+        UserDriven,
+        Shadow,
+        ColorTransition,
+        Decorative
+    };
+
+
+    // Watches the frame time of the animation driver and, while frames run
+    // over budget, degrades animations in priority order: shadows become
+    // static, then color transitions instant, then decorative animations
+    // tick at a lower rate. Scroll and user-driven motion are never touched.
+    // Levels are restored one by one once frames are back within budget.
+    // QFLUENT_ANIMATION_QUALITY=off disables it.
+    class AnimationQualityScheduler : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        enum Level {
+            Full = 0,
+            StaticShadows = 1,
+            InstantColors = 2,
+            ThrottledDecorations = 3
+        };
+        Q_ENUM(Level)
+
+        explicit AnimationQualityScheduler(QObject* parent = nullptr);
+
+        bool isEnabled() const { return enabled; }
+        void setEnabled(bool enabled);
+
+        Level level() const { return m_level; }
+        void setLevel(Level level);
+
+        // Frame budget in ms, 0 follows the display refresh rate
+        int frameBudget() const { return budget; }
+        void setFrameBudget(int msecs);
+
+        int throttledInterval() const { return 50; }
+
+        bool isInstant(AnimationRole role) const;
+        bool isThrottled(AnimationRole role) const;
+
+        // For updateCurrentTime(): true when a throttled role skips this tick
+        bool skipTick(AnimationRole role, int currentTime, int& lastApplied, int duration) const;
+
+        // Fed by the animation driver with the time between two ticks
+        void reportFrameInterval(qint64 interval, int expected);
+
+    signals:
+        void levelChanged(Level level);
+        void roleDegraded(AnimationRole role, bool degraded);
+
+    private:
+        bool enabled;
+        Level m_level;
+        int budget;
+        int overBudgetFrames;
+        int withinBudgetFrames;
+    };
+
+
+    AnimationQualityScheduler* animationQuality();
+
+}
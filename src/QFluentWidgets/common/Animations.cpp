@@ -1,12 +1,23 @@
 #include "Animations.hpp"
 
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+#include "QFluentWidgets/common/TypedAnimation.hpp"
+#include "QFluentWidgets/common/SpringAnimation.hpp"
+#include "QFluentWidgets/common/MotionPolicy.hpp"
+#include "QFluentWidgets/common/AnimationProfiler.hpp"
+#include "QFluentWidgets/common/EventDispatcher.hpp"
+#include "QFluentWidgets/common/BackgroundColorAnimator.hpp"
+
 namespace fluent {
 
 
     AnimationBase::AnimationBase(QWidget* parent)
         : QObject(parent)
     {
-        parent->installEventFilter(this);
+        animationDriver();
+        WidgetEventDispatcher::of(parent)->subscribe(this,
+            { QEvent::MouseButtonPress, QEvent::MouseButtonRelease, QEvent::Enter, QEvent::Leave },
+            [this](QWidget* w, QEvent* e) { return eventFilter(w, e); });
     }
 
 
@@ -38,7 +49,11 @@ namespace fluent {
     TranslateYAnimation::TranslateYAnimation(QWidget* parent, int offset)
         : AnimationBase(parent), m_y(0), maxOffset(offset)
     {
-        ani = new QPropertyAnimation(this, "y", this);
+        ani = new SpringAnimation<float>(this, &TranslateYAnimation::setY, this);
+        ani->setRole(AnimationRole::UserDriven);
+
+        // Pixels, the wobble below a tenth of one isn't worth a repaint
+        ani->setRestThreshold(0.1, 1);
     }
 
 
@@ -49,24 +64,22 @@ namespace fluent {
 
     void TranslateYAnimation::setY(float y) {
         m_y = y;
-        ((QWidget*)parent())->update();
+        animationDriver()->scheduleUpdate((QWidget*)parent());
         emit valueChanged(y);
     }
 
 
     void TranslateYAnimation::onPress(QMouseEvent* e) {
-        ani->setEndValue(maxOffset);
-        ani->setEasingCurve(QEasingCurve::OutQuad);
-        ani->setDuration(150);
-        ani->start();
+        ani->setStiffness(800);
+        ani->setDampingRatio(1);
+        ani->setTarget(maxOffset);
     }
 
 
     void TranslateYAnimation::onRelease(QMouseEvent* e) {
-        ani->setEndValue(0);
-        ani->setEasingCurve(QEasingCurve::OutElastic);
-        ani->setDuration(500);
-        ani->start();
+        ani->setStiffness(300);
+        ani->setDampingRatio(0.3);
+        ani->setTarget(0);
     }
 
 
@@ -84,7 +97,7 @@ namespace fluent {
     void BackgroundColorObject::setBackgroundColor(const QColor& color) {
         m_backgroundColor = color;
         if (parentWidget())
-            parentWidget()->update();
+            animationDriver()->scheduleUpdate(parentWidget());
     }
 
 
@@ -95,26 +108,32 @@ namespace fluent {
 
 
     BackgroundAnimationWidget::BackgroundAnimationWidget(QWidget* parent)
-        : QWidget(parent), isHover(false), isPressed(false),
-        bgColorObject(new BackgroundColorObject(this)),
-        backgroundColorAni(new QPropertyAnimation(bgColorObject, "backgroundColor", this))
+        : QWidget(parent), isHover(false), isPressed(false), m_backgroundColor(Qt::transparent)
     {
-        backgroundColorAni->setDuration(120);
-        installEventFilter(this);
+        animationDriver();
     }
 
 
-    bool BackgroundAnimationWidget::eventFilter(QObject* obj, QEvent* e) {
-        if (obj == this) {
-            switch (e->type()) {
-            case QEvent::EnabledChange:
-                updateBackgroundColor();
-                break;
-            default:
-                break;
-            }
+    BackgroundAnimationWidget::~BackgroundAnimationWidget() {
+        // Don't bring the animator back during application teardown
+        if (auto* animator = backgroundColorAnimator(false)) {
+            animator->remove(this);
         }
-        return QWidget::eventFilter(obj, e);
+    }
+
+
+    void BackgroundAnimationWidget::changeEvent(QEvent* e) {
+        if (e->type() == QEvent::EnabledChange) {
+            updateBackgroundColor();
+        }
+        QWidget::changeEvent(e);
+    }
+
+
+    void BackgroundAnimationWidget::setBackgroundColor(const QColor& color) {
+        backgroundColorAnimator()->remove(this);
+        m_backgroundColor = color;
+        animationDriver()->scheduleUpdate(this, backgroundRect());
     }
 
 
@@ -168,9 +187,7 @@ namespace fluent {
             color = normalBackgroundColor();
         }
 
-        backgroundColorAni->stop();
-        backgroundColorAni->setEndValue(color);
-        backgroundColorAni->start();
+        backgroundColorAnimator()->animate(this, &m_backgroundColor, color, 120, [this] { return backgroundRect(); });
     }
 
 
@@ -179,11 +196,19 @@ namespace fluent {
         const QColor& normalColor,
         const QColor& hoverColor
     ) : QPropertyAnimation(parent), normalColor(normalColor), hoverColor(hoverColor),
-        offset(0, 0), blurRadius(38), isHover(false)
+        offset(0, 0), blurRadius(38), cornerRadius(0), isHover(false), savedDuration(-1)
     {
-        shadowEffect = new QGraphicsDropShadowEffect(this);
-        shadowEffect->setColor(normalColor);
-        parent->installEventFilter(this);
+        animationDriver();
+        setPropertyName("opacity");
+        setDuration(150);
+        connect(this, &QPropertyAnimation::finished, this, &DropShadowAnimation::onAniFinished);
+        WidgetEventDispatcher::of(parent)->subscribe(this, { QEvent::Enter, QEvent::Leave, QEvent::MouseButtonPress },
+            [this](QWidget* w, QEvent* e) { return eventFilter(w, e); });
+    }
+
+
+    DropShadowAnimation::~DropShadowAnimation() {
+        delete shadow;
     }
 
 
@@ -192,17 +217,18 @@ namespace fluent {
             switch (e->type()) {
             case QEvent::Enter:
                 isHover = true;
-                if (state() != QPropertyAnimation::Running)
-                    ((QWidget*)parent())->setGraphicsEffect(createShadowEffect());
-                setEndValue(hoverColor);
-                start();
+                if (createShadow()) {
+                    stop();
+                    setEndValue(1.0);
+                    start();
+                }
                 break;
             case QEvent::Leave:
             case QEvent::MouseButtonPress:
                 isHover = false;
-                if (((QWidget*)parent())->graphicsEffect()) {
-                    connect(this, &QPropertyAnimation::finished, this, &DropShadowAnimation::onAniFinished);
-                    setEndValue(normalColor);
+                if (shadow) {
+                    stop();
+                    setEndValue(normalOpacity());
                     start();
                 }
                 break;
@@ -214,36 +240,86 @@ namespace fluent {
     }
 
 
-    QGraphicsDropShadowEffect* DropShadowAnimation::createShadowEffect() {
-        shadowEffect = new QGraphicsDropShadowEffect(this);
-        shadowEffect->setOffset(offset);
-        shadowEffect->setBlurRadius(blurRadius);
-        shadowEffect->setColor(normalColor);
+    void DropShadowAnimation::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) {
+        applyMotionPolicy(this, AnimationRole::Shadow, newState, oldState, savedDuration);
+        animationProfiler()->stateChanged(this, targetObject(), newState);
+        QPropertyAnimation::updateState(newState, oldState);
+    }
 
-        setTargetObject(shadowEffect);
-        setStartValue(shadowEffect->color());
-        setPropertyName("color");
-        setDuration(150);
 
-        return shadowEffect;
+    void DropShadowAnimation::updateCurrentTime(int currentTime) {
+        QPropertyAnimation::updateCurrentTime(currentTime);
+        animationProfiler()->ticked(this);
+    }
+
+
+    ShadowWidget* DropShadowAnimation::createShadow() {
+        // The shadow is drawn by a sibling, a top-level window has none
+        auto* widget = (QWidget*)parent();
+        if (!shadow && widget->parentWidget()) {
+            shadow = new ShadowWidget(widget);
+            shadow->setOpacity(normalOpacity());
+            setTargetObject(shadow);
+            updateShadowStyle();
+        }
+
+        if (shadow && widget->isVisible()) {
+            shadow->show();
+        }
+        return shadow;
+    }
+
+
+    void DropShadowAnimation::updateShadowStyle() {
+        if (!shadow) {
+            return;
+        }
+
+        ShadowStyle style;
+        style.blurRadius = blurRadius;
+        style.offset = offset;
+        style.cornerRadius = cornerRadius;
+        style.color = hoverColor;
+        shadow->setStyle(style);
+    }
+
+
+    // The shadow is rendered in the hover color, the normal state is the same
+    // shadow at the alpha ratio of the two colors
+    qreal DropShadowAnimation::normalOpacity() const {
+        if (hoverColor.alpha() == 0) {
+            return 0;
+        }
+        return qMin<qreal>(1, normalColor.alphaF() / hoverColor.alphaF());
     }
 
 
     void DropShadowAnimation::onAniFinished() {
-        disconnect(this, &QPropertyAnimation::finished, this, &DropShadowAnimation::onAniFinished);
-        shadowEffect = nullptr;
-        ((QWidget*)parent())->setGraphicsEffect(nullptr);
+        if (!isHover && shadow && qFuzzyIsNull(shadow->opacity())) {
+            shadow->hide();
+        }
     }
 
 
 
     FluentAnimation::FluentAnimation(QWidget* parent)
-        : QPropertyAnimation(parent) {
+        : QPropertyAnimation(parent), preset(&motion::linear), savedDuration(-1), lastApplied(0),
+        m_role(AnimationRole::Decorative) {
+        animationDriver();
         setSpeed(FluentAnimationSpeed::FAST);
         setEasingCurve(curve());
     }
 
 
+    FluentAnimation::FluentAnimation(QWidget* parent, FluentAnimationType aniType)
+        : QPropertyAnimation(parent), preset(&motion::presets[static_cast<int>(aniType)]), savedDuration(-1),
+        lastApplied(0), m_role(AnimationRole::Decorative) {
+        animationDriver();
+        setSpeed(FluentAnimationSpeed::FAST);
+        setEasingCurve(curve(aniType));
+    }
+
+
     QEasingCurve FluentAnimation::createBezierCurve(
         qreal x1,
         qreal y1,
@@ -261,13 +337,24 @@ namespace fluent {
     }
 
 
+    QEasingCurve FluentAnimation::curve(FluentAnimationType aniType) {
+        return motionCurve(static_cast<int>(aniType));
+    }
+
+
+    void FluentAnimation::setAnimationType(FluentAnimationType aniType) {
+        preset = &motion::presets[static_cast<int>(aniType)];
+        setEasingCurve(curve(aniType));
+    }
+
+
     void FluentAnimation::setSpeed(FluentAnimationSpeed speed) {
         setDuration(speedToDuration(speed));
     }
 
 
     int FluentAnimation::speedToDuration(FluentAnimationSpeed speed) const {
-        return 100;
+        return preset->durations[static_cast<int>(speed)];
     }
 
 
@@ -289,13 +376,29 @@ namespace fluent {
     }
 
 
+    void FluentAnimation::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) {
+        applyMotionPolicy(this, m_role, newState, oldState, savedDuration);
+        animationProfiler()->stateChanged(this, targetObject() ? targetObject() : parent(), newState);
+        QPropertyAnimation::updateState(newState, oldState);
+    }
+
+
+    void FluentAnimation::updateCurrentTime(int currentTime) {
+        if (animationQuality()->skipTick(m_role, currentTime, lastApplied, duration())) {
+            return;
+        }
+        QPropertyAnimation::updateCurrentTime(currentTime);
+        animationProfiler()->ticked(this);
+    }
+
+
     QVariant FluentAnimation::value() const {
-        return targetObject()->property("value");
+        return targetObject()->property(propertyName());
     }
 
 
     void FluentAnimation::setValue(const QVariant& value) {
-        targetObject()->setProperty("value", value);
+        targetObject()->setProperty(propertyName(), value);
     }
 
 
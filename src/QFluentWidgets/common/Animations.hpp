@@ -6,7 +6,7 @@
 #include <QPropertyAnimation>
 #include <QMouseEvent>
 #include <QEvent>
-#include <QGraphicsDropShadowEffect>
+#include <QPointer>
 #include <QLineEdit>
 #include <QPoint>
 #include <QEasingCurve>
@@ -15,9 +15,20 @@
 #include <QObject>
 #include <QEvent>
 
+#include "QFluentWidgets/common/Motion.hpp"
+#include "QFluentWidgets/common/AnimationQuality.hpp"
+#include "QFluentWidgets/common/Shadow.hpp"
+
 
 namespace fluent {
 
+    template <typename T>
+    class TypedAnimation;
+
+    template <typename T>
+    class SpringAnimation;
+
+
     // Enums for FluentAnimation
     enum class FluentAnimationSpeed {
         FAST = 0,
@@ -90,7 +101,7 @@ namespace fluent {
     private:
         float m_y;
         int maxOffset;
-        QPropertyAnimation* ani;
+        SpringAnimation<float>* ani;
     };
 
 
@@ -115,20 +126,25 @@ namespace fluent {
 
     public:
         explicit BackgroundAnimationWidget(QWidget* parent = nullptr);
+        ~BackgroundAnimationWidget();
 
     protected:
-        bool eventFilter(QObject* obj, QEvent* e) override;
+        void changeEvent(QEvent* e) override;
         void mousePressEvent(QMouseEvent* e) override;
         void mouseReleaseEvent(QMouseEvent* e) override;
         void enterEvent(QEnterEvent* e) override; //TODO check it
         void leaveEvent(QEvent* e) override;
         void focusInEvent(QFocusEvent* e) override;
 
+        // Area repainted while the background color animates
+        virtual QRect backgroundRect() const {
+            return rect();
+        }
+
     private:
         bool isHover;
         bool isPressed;
-        BackgroundColorObject* bgColorObject;
-        QPropertyAnimation* backgroundColorAni;
+        QColor m_backgroundColor;
 
         QColor normalBackgroundColor() const {
             return QColor(0, 0, 0, 0);
@@ -153,30 +169,38 @@ namespace fluent {
         void updateBackgroundColor();
 
         QColor getBackgroundColor() const {
-            return bgColorObject->backgroundColor();
+            return m_backgroundColor;
         }
 
-        void setBackgroundColor(const QColor& color) {
-            bgColorObject->setBackgroundColor(color);
-        }
+        void setBackgroundColor(const QColor& color);
 
     public:
         Q_PROPERTY(QColor backgroundColor READ getBackgroundColor WRITE setBackgroundColor);
     };
 
 
+    // Hover shadow painted from a cached nine-patch by a ShadowWidget under
+    // the parent, only its opacity is animated
     class DropShadowAnimation : public QPropertyAnimation {
         Q_OBJECT
 
     public:
         explicit DropShadowAnimation(QWidget* parent = nullptr, const QColor& normalColor = QColor(0, 0, 0, 0), const QColor& hoverColor = QColor(0, 0, 0, 75));
+        ~DropShadowAnimation();
 
         void setBlurRadius(int radius) {
             blurRadius = radius;
+            updateShadowStyle();
         }
 
         void setOffset(int dx, int dy) {
             offset = QPoint(dx, dy);
+            updateShadowStyle();
+        }
+
+        void setCornerRadius(int radius) {
+            cornerRadius = radius;
+            updateShadowStyle();
         }
 
         void setNormalColor(const QColor& color) {
@@ -185,10 +209,13 @@ namespace fluent {
 
         void setHoverColor(const QColor& color) {
             hoverColor = color;
+            updateShadowStyle();
         }
 
     protected:
         bool eventFilter(QObject* obj, QEvent* e) override;
+        void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) override;
+        void updateCurrentTime(int currentTime) override;
 
     private slots:
         void onAniFinished();
@@ -198,10 +225,14 @@ namespace fluent {
         QColor hoverColor;
         QPoint offset;
         int blurRadius;
+        int cornerRadius;
         bool isHover;
-        QGraphicsDropShadowEffect* shadowEffect;
+        int savedDuration;
+        QPointer<ShadowWidget> shadow;
 
-        QGraphicsDropShadowEffect* createShadowEffect();
+        ShadowWidget* createShadow();
+        void updateShadowStyle();
+        qreal normalOpacity() const;
     };
 
 
@@ -210,9 +241,16 @@ namespace fluent {
         Q_OBJECT
     public:
         explicit FluentAnimation(QWidget* parent = nullptr);
+        FluentAnimation(QWidget* parent, FluentAnimationType aniType);
 
         static QEasingCurve createBezierCurve(qreal x1, qreal y1, qreal x2, qreal y2);
         static QEasingCurve curve();
+        static QEasingCurve curve(FluentAnimationType aniType);
+
+        void setAnimationType(FluentAnimationType aniType);
+
+        AnimationRole role() const { return m_role; }
+        void setRole(AnimationRole role) { m_role = role; }
 
         void setSpeed(FluentAnimationSpeed speed);
         int speedToDuration(FluentAnimationSpeed speed) const;
@@ -225,8 +263,9 @@ namespace fluent {
         template <typename T>
         static FluentAnimation* create(FluentAnimationType aniType, FluentAnimationProperty propertyType,
             FluentAnimationSpeed speed = FluentAnimationSpeed::FAST, const QVariant& value = QVariant(), QWidget* parent = nullptr) {
-            T* obj = new T(parent);
-            FluentAnimation* ani = new FluentAnimation(parent);
+            // The target belongs to the animation and goes away with it
+            FluentAnimation* ani = new FluentAnimation(parent, aniType);
+            T* obj = new T(ani);
 
             ani->setSpeed(speed);
             ani->setTargetObject(obj);
@@ -238,6 +277,25 @@ namespace fluent {
 
             return ani;
         }
+
+        // QVariant-free counterpart of create(), defined in TypedAnimation.hpp
+        template <typename T, typename Setter>
+        static TypedAnimation<T>* createTyped(FluentAnimationType aniType, Setter setter,
+            FluentAnimationSpeed speed = FluentAnimationSpeed::FAST, QObject* parent = nullptr);
+
+        // Retargetable spring, defined in SpringAnimation.hpp
+        template <typename T, typename Setter>
+        static SpringAnimation<T>* createSpring(Setter setter, QObject* parent = nullptr);
+
+    protected:
+        void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) override;
+        void updateCurrentTime(int currentTime) override;
+
+    private:
+        const MotionPreset* preset;
+        int savedDuration;
+        int lastApplied;
+        AnimationRole m_role;
     };
 
 
@@ -0,0 +1,100 @@
+#include "BackgroundColorAnimator.hpp"
+
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+#include "QFluentWidgets/common/MotionPolicy.hpp"
+#include "QFluentWidgets/common/TypedAnimation.hpp"
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <algorithm>
+
+namespace fluent {
+
+    BackgroundColorAnimator::BackgroundColorAnimator(QObject* parent)
+        : QObject(parent)
+    {
+        ticker = new AnimationTicker([this](int currentTime) { tick(currentTime); }, this);
+    }
+
+
+    void BackgroundColorAnimator::animate(QWidget* widget, QColor* color, const QColor& target, int duration, RectFunction rect) {
+        auto it = std::find_if(records.begin(), records.end(), [widget](const Record& record) {
+            return record.widget == widget;
+        });
+
+        if (isInstantMotion(AnimationRole::ColorTransition) || duration <= 0 || *color == target) {
+            if (it != records.end()) {
+                *it = records.back();
+                records.pop_back();
+            }
+            *color = target;
+            animationDriver()->scheduleUpdate(widget, rect());
+            return;
+        }
+
+        Record record { widget, color, color->rgba(), target.rgba(), now(), duration, std::move(rect) };
+        if (it != records.end()) {
+            *it = record;
+        }
+        else {
+            records.push_back(record);
+        }
+
+        if (ticker->state() != QAbstractAnimation::Running) {
+            ticker->start();
+        }
+    }
+
+
+    void BackgroundColorAnimator::remove(QWidget* widget) {
+        for (size_t i = 0; i < records.size(); ++i) {
+            if (records[i].widget == widget) {
+                records[i] = records.back();
+                records.pop_back();
+                break;
+            }
+        }
+
+        if (records.empty()) {
+            ticker->stop();
+        }
+    }
+
+
+    int BackgroundColorAnimator::now() const {
+        return ticker->state() == QAbstractAnimation::Running ? ticker->currentTime() : 0;
+    }
+
+
+    void BackgroundColorAnimator::tick(int currentTime) {
+        for (size_t i = 0; i < records.size();) {
+            Record& record = records[i];
+            qreal progress = qMin<qreal>(1, qreal(currentTime - record.start) / record.duration);
+
+            *record.color = AnimationTraits<QColor>::lerp(QColor::fromRgba(record.from), QColor::fromRgba(record.to), progress);
+            animationDriver()->scheduleUpdate(record.widget, record.rect());
+
+            if (progress >= 1) {
+                record = records.back();
+                records.pop_back();
+            }
+            else {
+                ++i;
+            }
+        }
+
+        if (records.empty()) {
+            ticker->stop();
+        }
+    }
+
+
+    BackgroundColorAnimator* backgroundColorAnimator(bool create) {
+        static QPointer<BackgroundColorAnimator> animator;
+        if (!animator && create) {
+            animator = new BackgroundColorAnimator(QCoreApplication::instance());
+        }
+        return animator;
+    }
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QObject>
+#include <QWidget>
+#include <QColor>
+#include <QRect>
+#include <functional>
+#include <vector>
+
+namespace fluent {
+
+    class AnimationTicker;
+
+
+    // Background color transitions of every BackgroundAnimationWidget. The
+    // running transitions are (widget, from, to, start) records in one
+    // array, advanced in a single pass per frame by one shared ticker, and
+    // each widget only repaints its background rect.
+    class BackgroundColorAnimator : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        // Area of the widget to repaint, read on every frame so it follows resizes
+        using RectFunction = std::function<QRect()>;
+
+        explicit BackgroundColorAnimator(QObject* parent = nullptr);
+
+        // Moves *color to target, retargeting from the current color if the
+        // widget is already in transition
+        void animate(QWidget* widget, QColor* color, const QColor& target, int duration, RectFunction rect);
+
+        // Must be called before the widget or the color goes away
+        void remove(QWidget* widget);
+
+        int activeCount() const { return int(records.size()); }
+
+    private:
+        struct Record {
+            QWidget* widget;
+            QColor* color;
+            QRgb from;
+            QRgb to;
+            int start;
+            int duration;
+            RectFunction rect;
+        };
+
+        std::vector<Record> records;
+        AnimationTicker* ticker;
+
+        int now() const;
+        void tick(int currentTime);
+    };
+
+
+    // Owned by the application, must be used on the GUI thread. Without create
+    // it is null until first used and again once the application has gone.
+    BackgroundColorAnimator* backgroundColorAnimator(bool create = true);
+
+}
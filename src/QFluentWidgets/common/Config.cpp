@@ -1,6 +1,6 @@
 #include "Config.hpp"
 
-#include "QFluentWidgets/utils/OS.hpp"
+#include "QFluentWidgets/common/ThemeState.hpp"
 
 #include <QRgb>
 
@@ -182,16 +182,12 @@ namespace fluent {
     QConfig::QConfig(QObject* parent) : QObject(parent) {
         
         // Fetch theme mode from system
-        themeMode = new OptionsConfigItem("QFluentWidgets", "ThemeMode", QVariant::fromValue(os::isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light),
+        themeMode = new OptionsConfigItem("QFluentWidgets", "ThemeMode", QVariant::fromValue(themeState()->isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light),
             new OptionsValidator({ "Light", "Dark", "Auto" }), new EnumSerializer(QMetaEnum::fromType<Theme::Mode>()));
         
         
         // Fetch primary color from system
-        auto vcc = os::getPrimaryColor();
-        QColor color;
-        color.setRgbF(vcc.r, vcc.g, vcc.b, vcc.a);
-
-        themeColor = new ColorConfigItem("QFluentWidgets", "ThemeColor", color);
+        themeColor = new ColorConfigItem("QFluentWidgets", "ThemeColor", themeState()->accentColor());
 
         configItems.insert(themeMode->key(), themeMode);
         configItems.insert(themeColor->key(), themeColor);
@@ -328,6 +324,14 @@ namespace fluent {
     }
 
 
+    Q_GLOBAL_STATIC(QConfig, globalConfig);
+
+
+    QConfig* qconfigInstance() {
+        return globalConfig();
+    }
+
+
     bool isDarkTheme() {
         return qconfig->get(qconfig->themeMode).toString() == "Dark";
     }
@@ -226,7 +226,16 @@ namespace fluent {
     };
 
 
-    Q_GLOBAL_STATIC(QConfig, qconfig);
+    QConfig* qconfigInstance();
+
+    // A Q_GLOBAL_STATIC declared in a header creates one instance per
+    // translation unit, route every `qconfig->` through the same object.
+    struct QConfigAccessor {
+        QConfig* operator->() const { return qconfigInstance(); }
+        operator QConfig*() const { return qconfigInstance(); }
+    };
+
+    inline constexpr QConfigAccessor qconfig{};
 
 
     bool isDarkTheme();
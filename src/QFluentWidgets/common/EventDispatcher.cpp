@@ -0,0 +1,152 @@
+#include "EventDispatcher.hpp"
+
+#include <QElapsedTimer>
+#include <algorithm>
+
+namespace fluent {
+
+    static WidgetEventDispatcher::Stats dispatchStats;
+    static bool profiling = false;
+
+
+    EventTypeMask::EventTypeMask(std::initializer_list<QEvent::Type> types) {
+        for (auto type : types) {
+            if (type < Size) {
+                bits.set(type);
+            }
+            else {
+                other = true;
+            }
+        }
+    }
+
+
+    bool EventTypeMask::contains(QEvent::Type type) const {
+        return type < Size ? bits.test(type) : other;
+    }
+
+
+    EventTypeMask& EventTypeMask::operator|=(const EventTypeMask& other) {
+        bits |= other.bits;
+        this->other = this->other || other.other;
+        return *this;
+    }
+
+
+
+    WidgetEventDispatcher::WidgetEventDispatcher(QWidget* widget)
+        : QObject(widget), widget(widget), dispatching(0), removalPending(false)
+    {
+        setObjectName("fluent_event_dispatcher");
+        widget->installEventFilter(this);
+    }
+
+
+    WidgetEventDispatcher* WidgetEventDispatcher::of(QWidget* widget) {
+        auto* dispatcher = widget->findChild<WidgetEventDispatcher*>("fluent_event_dispatcher", Qt::FindDirectChildrenOnly);
+        return dispatcher ? dispatcher : new WidgetEventDispatcher(widget);
+    }
+
+
+    void WidgetEventDispatcher::subscribe(QObject* owner, const EventTypeMask& mask, EventHandler handler) {
+        subscriptions.push_back({ owner, mask, std::move(handler) });
+        combinedMask |= mask;
+
+        if (owner != this && owner != widget) {
+            connect(owner, &QObject::destroyed, this, [this, owner] { unsubscribe(owner); }, Qt::UniqueConnection);
+        }
+    }
+
+
+    void WidgetEventDispatcher::unsubscribe(QObject* owner) {
+        for (auto& subscription : subscriptions) {
+            if (subscription.owner == owner || subscription.owner.isNull()) {
+                subscription.handler = nullptr;
+                removalPending = true;
+            }
+        }
+
+        if (!dispatching) {
+            compact();
+        }
+    }
+
+
+    int WidgetEventDispatcher::subscriberCount() const {
+        int count = 0;
+        for (const auto& subscription : subscriptions) {
+            count += subscription.handler ? 1 : 0;
+        }
+        return count;
+    }
+
+
+    WidgetEventDispatcher::Stats WidgetEventDispatcher::stats() {
+        return dispatchStats;
+    }
+
+
+    void WidgetEventDispatcher::resetStats() {
+        dispatchStats = Stats();
+    }
+
+
+    void WidgetEventDispatcher::setProfiling(bool enabled) {
+        profiling = enabled;
+    }
+
+
+    bool WidgetEventDispatcher::eventFilter(QObject* watched, QEvent* event) {
+        ++dispatchStats.events;
+        if (watched != widget || !combinedMask.contains(event->type())) {
+            return false;
+        }
+
+        ++dispatchStats.dispatched;
+        QElapsedTimer timer;
+        if (profiling) {
+            timer.start();
+        }
+
+        // Handlers may subscribe or unsubscribe while being called
+        bool consumed = false;
+        ++dispatching;
+        for (size_t i = 0; i < subscriptions.size() && !consumed; ++i) {
+            if (!subscriptions[i].handler || !subscriptions[i].mask.contains(event->type())) {
+                continue;
+            }
+
+            ++dispatchStats.handlerCalls;
+            EventHandler handler = subscriptions[i].handler;
+            consumed = handler(widget, event);
+        }
+        --dispatching;
+
+        if (!dispatching && removalPending) {
+            compact();
+        }
+
+        if (profiling) {
+            dispatchStats.dispatchNs += timer.nsecsElapsed();
+        }
+        return consumed;
+    }
+
+
+    void WidgetEventDispatcher::rebuildMask() {
+        combinedMask = EventTypeMask();
+        for (const auto& subscription : subscriptions) {
+            combinedMask |= subscription.mask;
+        }
+    }
+
+
+    void WidgetEventDispatcher::compact() {
+        removalPending = false;
+        subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(), [](const Subscription& subscription) {
+            return !subscription.handler;
+        }), subscriptions.end());
+        rebuildMask();
+    }
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QObject>
+#include <QWidget>
+#include <QEvent>
+#include <QPointer>
+#include <bitset>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+namespace fluent {
+
+    // Set of event types a subscriber wants. Built-in types below Size are
+    // tested with one bit, the rare ones above it are always delivered.
+    class EventTypeMask
+    {
+    public:
+        static constexpr int Size = 256;
+
+        EventTypeMask() = default;
+        EventTypeMask(std::initializer_list<QEvent::Type> types);
+
+        bool contains(QEvent::Type type) const;
+        EventTypeMask& operator|=(const EventTypeMask& other);
+
+    private:
+        std::bitset<Size> bits;
+        bool other = false;
+    };
+
+
+    using EventHandler = std::function<bool(QWidget* widget, QEvent* event)>;
+
+
+    // One event filter per widget shared by all Fluent helpers watching it.
+    // An event is rejected with a single mask test unless a subscriber asked
+    // for its type, and then only reaches those subscribers. A handler
+    // returning true consumes the event.
+    class WidgetEventDispatcher : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        struct Stats {
+            qint64 events = 0;
+            qint64 dispatched = 0;
+            qint64 handlerCalls = 0;
+            qint64 dispatchNs = 0;
+        };
+
+        // Finds or creates the dispatcher of widget
+        static WidgetEventDispatcher* of(QWidget* widget);
+
+        // The subscription ends when owner is destroyed or unsubscribes
+        void subscribe(QObject* owner, const EventTypeMask& mask, EventHandler handler);
+        void unsubscribe(QObject* owner);
+
+        int subscriberCount() const;
+
+        // Counters of every dispatcher; the time is only measured while profiling
+        static Stats stats();
+        static void resetStats();
+        static void setProfiling(bool enabled);
+
+    protected:
+        bool eventFilter(QObject* watched, QEvent* event) override;
+
+    private:
+        struct Subscription {
+            QPointer<QObject> owner;
+            EventTypeMask mask;
+            EventHandler handler;
+        };
+
+        explicit WidgetEventDispatcher(QWidget* widget);
+
+        QWidget* widget;
+        EventTypeMask combinedMask;
+        std::vector<Subscription> subscriptions;
+        int dispatching;
+        bool removalPending;
+
+        void rebuildMask();
+        void compact();
+    };
+
+}
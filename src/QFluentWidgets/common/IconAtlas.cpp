@@ -0,0 +1,170 @@
+#include "IconAtlas.hpp"
+
+#include "QFluentWidgets/common/Icons.hpp"
+#include "QFluentWidgets/common/IconRasterizer.hpp"
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QSvgRenderer>
+
+namespace fluent {
+
+    IconAtlas::IconAtlas(QObject* parent)
+        : QObject(parent), enabled(qEnvironmentVariable("QFLUENT_ICON_ATLAS") != "0")
+    {}
+
+
+    bool IconAtlas::supports(const QSize& size, qreal dpr) {
+        if (size.width() != size.height() || (dpr != 1.0 && dpr != 2.0)) {
+            return false;
+        }
+
+        switch (size.width()) {
+        case 16:
+        case 20:
+        case 24:
+        case 32:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+
+    bool IconAtlas::draw(QPainter* painter, const QRect& rect, const QString& iconPath, qreal opacity) {
+        if (!enabled || !painter->device() || !iconPath.endsWith(".svg")) {
+            return false;
+        }
+
+        qreal dpr = painter->device()->devicePixelRatioF();
+        if (!supports(rect.size(), dpr)) {
+            return false;
+        }
+
+        int cell = qRound(rect.width() * dpr);
+        Slot slot;
+        auto it = slots.constFind(slotKey(iconPath, cell));
+        if (it != slots.cend()) {
+            slot = *it;
+        }
+        else if (QWidget* widget = iconRasterizer()->deferrableWidget(painter)) {
+            prefetch(iconPath, cell, widget);
+            return true;
+        }
+        else if (!place(iconPath, cell, renderCell(iconPath, cell), &slot)) {
+            return false;
+        }
+
+        qreal oldOpacity = painter->opacity();
+        painter->setOpacity(oldOpacity * opacity);
+        painter->drawPixmap(QRectF(rect), pageSets[cell].pages.at(slot.page), QRectF(slot.rect));
+        painter->setOpacity(oldOpacity);
+        return true;
+    }
+
+
+    void IconAtlas::prefetch(const QString& iconPath, int cell, QWidget* requester) {
+        if (!enabled || slots.contains(slotKey(iconPath, cell))) {
+            return;
+        }
+
+        IconCacheKey key;
+        key.icon = "atlas:" + iconPath;
+        key.size = QSize(cell, cell);
+
+        QPointer<IconAtlas> atlas(this);
+        iconRasterizer()->request(key,
+            [iconPath, cell] { return renderCell(iconPath, cell); },
+            [atlas, iconPath, cell](const QImage& image) {
+                Slot slot;
+                if (atlas && atlas->enabled && !atlas->slots.contains(slotKey(iconPath, cell))) {
+                    atlas->place(iconPath, cell, image, &slot);
+                }
+            },
+            requester);
+    }
+
+
+    void IconAtlas::setEnabled(bool enabled) {
+        this->enabled = enabled;
+        if (!enabled) {
+            clear();
+        }
+    }
+
+
+    IconAtlasStats IconAtlas::stats() const {
+        IconAtlasStats stats;
+        stats.icons = slots.size();
+        for (const auto& set : pageSets) {
+            stats.pages += set.pages.size();
+            for (const auto& page : set.pages) {
+                stats.bytes += qint64(page.width()) * page.height() * qMax(1, page.depth() / 8);
+            }
+        }
+        return stats;
+    }
+
+
+    void IconAtlas::clear() {
+        pageSets.clear();
+        slots.clear();
+    }
+
+
+    QString IconAtlas::slotKey(const QString& iconPath, int cell) {
+        return QString::number(cell) + ':' + iconPath;
+    }
+
+
+    QImage IconAtlas::renderCell(const QString& iconPath, int cell) {
+        QSvgRenderer renderer(svgSource(iconPath));
+        if (!renderer.isValid()) {
+            return QImage();
+        }
+
+        QImage image(cell, cell, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        renderer.render(&painter, QRectF(0, 0, cell, cell));
+        painter.end();
+        return image;
+    }
+
+
+    bool IconAtlas::place(const QString& iconPath, int cell, const QImage& image, Slot* slot) {
+        if (image.isNull()) {
+            return false;
+        }
+
+        PageSet& set = pageSets[cell];
+        if (set.used == set.pages.size() * cellsPerPage) {
+            QPixmap page(cell * cellsPerRow, cell * cellsPerRow);
+            page.fill(Qt::transparent);
+            set.pages.append(page);
+        }
+
+        int index = set.used++;
+        slot->page = index / cellsPerPage;
+        slot->rect = QRect((index % cellsPerRow) * cell, (index % cellsPerPage) / cellsPerRow * cell, cell, cell);
+
+        QPainter painter(&set.pages[slot->page]);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(slot->rect.topLeft(), image);
+        painter.end();
+
+        slots.insert(slotKey(iconPath, cell), *slot);
+        return true;
+    }
+
+
+    IconAtlas* iconAtlas() {
+        static QPointer<IconAtlas> atlas;
+        if (!atlas) {
+            atlas = new IconAtlas(QCoreApplication::instance());
+        }
+        return atlas;
+    }
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QObject>
+#include <QPainter>
+#include <QPixmap>
+#include <QString>
+#include <QHash>
+#include <QVector>
+#include <QRect>
+#include <QImage>
+#include <QWidget>
+
+namespace fluent {
+
+    struct IconAtlasStats {
+        int pages = 0;
+        int icons = 0;
+        qint64 bytes = 0;
+    };
+
+
+    // Square svg icons at the common sizes (16, 20, 24 and 32 at 1x and 2x)
+    // rasterized on first use into shared pages of 16 x 16 cells, one set of
+    // pages per cell size in device pixels. Drawing an icon is a sub-rect
+    // drawPixmap. Only icons without a compiled vector (vectorIndex() < 0)
+    // come here, the built-in FluentIcons are tinted from IconMaskCache.
+    // Set QFLUENT_ICON_ATLAS=0 to turn it off.
+    class IconAtlas : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit IconAtlas(QObject* parent = nullptr);
+
+        static bool supports(const QSize& size, qreal dpr);
+
+        // Returns false if the icon can't be served from the atlas, the caller
+        // then draws it another way
+        // When painting a widget on screen, a missing icon is rasterized on a
+        // worker and the widget repainted, until then nothing is drawn
+        bool draw(QPainter* painter, const QRect& rect, const QString& iconPath, qreal opacity = 1.0);
+
+        // Fills the cell of the icon at cell x cell device pixels in the background
+        void prefetch(const QString& iconPath, int cell, QWidget* requester = nullptr);
+
+        bool isEnabled() const { return enabled; }
+        void setEnabled(bool enabled);
+
+        IconAtlasStats stats() const;
+        void clear();
+
+    private:
+        static constexpr int cellsPerRow = 16;
+        static constexpr int cellsPerPage = cellsPerRow * cellsPerRow;
+
+        struct Slot {
+            int page;
+            QRect rect;
+        };
+
+        struct PageSet {
+            QVector<QPixmap> pages;
+            int used = 0;
+        };
+
+        QHash<int, PageSet> pageSets;
+        QHash<QString, Slot> slots;
+        bool enabled;
+
+        static QString slotKey(const QString& iconPath, int cell);
+        static QImage renderCell(const QString& iconPath, int cell);
+        bool place(const QString& iconPath, int cell, const QImage& image, Slot* slot);
+    };
+
+
+    // Owned by the application, must be used on the GUI thread
+    IconAtlas* iconAtlas();
+
+}
@@ -0,0 +1,96 @@
+#include "IconCache.hpp"
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QHashFunctions>
+
+namespace fluent {
+
+    size_t qHash(const IconCacheKey& key, size_t seed) {
+        return qHashMulti(seed, key.icon, int(key.theme), key.tint, key.size.width(), key.size.height(),
+            key.dpr, int(key.mode), int(key.state));
+    }
+
+
+    IconCache::IconCache(QObject* parent)
+        : QObject(parent), hits(0), misses(0), inserted(0), removed(0)
+    {
+        bool ok = false;
+        int megabytes = qEnvironmentVariableIntValue("QFLUENT_ICON_CACHE_MB", &ok);
+        setMaxBytes(qint64(ok ? qMax(0, megabytes) : 8) * 1024 * 1024);
+    }
+
+
+    bool IconCache::find(const IconCacheKey& key, QPixmap* pixmap) {
+        // object() moves the entry to the front of the LRU list
+        if (const QPixmap* cached = cache.object(key)) {
+            ++hits;
+            *pixmap = *cached;
+            return true;
+        }
+        ++misses;
+        return false;
+    }
+
+
+    void IconCache::insert(const IconCacheKey& key, const QPixmap& pixmap) {
+        if (pixmap.isNull()) {
+            return;
+        }
+
+        if (cache.contains(key)) {
+            ++removed;
+        }
+
+        // An icon larger than the whole budget is dropped by QCache right away
+        if (cache.insert(key, new QPixmap(pixmap), cost(pixmap))) {
+            ++inserted;
+        }
+    }
+
+
+    void IconCache::setMaxBytes(qint64 bytes) {
+        cache.setMaxCost(qMax<qint64>(0, bytes));
+    }
+
+
+    IconCacheStats IconCache::stats() const {
+        IconCacheStats stats;
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.evictions = inserted - removed - cache.count();
+        stats.count = cache.count();
+        stats.bytes = cache.totalCost();
+        stats.maxBytes = cache.maxCost();
+        return stats;
+    }
+
+
+    void IconCache::resetStats() {
+        hits = 0;
+        misses = 0;
+        inserted = cache.count();
+        removed = 0;
+    }
+
+
+    void IconCache::clear() {
+        removed += cache.count();
+        cache.clear();
+    }
+
+
+    qint64 IconCache::cost(const QPixmap& pixmap) {
+        return qint64(pixmap.width()) * pixmap.height() * qMax(1, pixmap.depth() / 8);
+    }
+
+
+    IconCache* iconCache() {
+        static QPointer<IconCache> cache;
+        if (!cache) {
+            cache = new IconCache(QCoreApplication::instance());
+        }
+        return cache;
+    }
+
+}
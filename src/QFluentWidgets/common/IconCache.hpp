@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QObject>
+#include <QCache>
+#include <QPixmap>
+#include <QString>
+#include <QSize>
+#include <QColor>
+#include <QIcon>
+
+#include "QFluentWidgets/common/Config.hpp"
+
+namespace fluent {
+
+    // Everything a rasterized icon depends on. icon is the resource path or
+    // any other stable id of the source, theme is resolved (never Auto) and
+    // tint is 0 when the icon is drawn with its own colors.
+    struct IconCacheKey {
+        QString icon;
+        Theme::Mode theme = Theme::Mode::Light;
+        QRgb tint = 0;
+        QSize size;
+        qreal dpr = 1.0;
+        QIcon::Mode mode = QIcon::Normal;
+        QIcon::State state = QIcon::Off;
+
+        bool operator==(const IconCacheKey& other) const {
+            return icon == other.icon && theme == other.theme && tint == other.tint && size == other.size
+                && dpr == other.dpr && mode == other.mode && state == other.state;
+        }
+    };
+
+    size_t qHash(const IconCacheKey& key, size_t seed = 0);
+
+
+    struct IconCacheStats {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        qint64 evictions = 0;
+        int count = 0;
+        qint64 bytes = 0;
+        qint64 maxBytes = 0;
+    };
+
+
+    // Least recently used icon rasters, bounded by their size in bytes.
+    // The default budget of 8 MB can be changed with QFLUENT_ICON_CACHE_MB.
+    class IconCache : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit IconCache(QObject* parent = nullptr);
+
+        bool find(const IconCacheKey& key, QPixmap* pixmap);
+        void insert(const IconCacheKey& key, const QPixmap& pixmap);
+
+        // Cached raster for key, or the result of render() which is cached
+        template <typename Render>
+        QPixmap pixmap(const IconCacheKey& key, Render&& render) {
+            QPixmap result;
+            if (!find(key, &result)) {
+                result = render();
+                insert(key, result);
+            }
+            return result;
+        }
+
+        qint64 maxBytes() const { return cache.maxCost(); }
+        void setMaxBytes(qint64 bytes);
+
+        IconCacheStats stats() const;
+        void resetStats();
+        void clear();
+
+    private:
+        QCache<IconCacheKey, QPixmap> cache;
+        qint64 hits;
+        qint64 misses;
+        qint64 inserted;
+        qint64 removed;
+
+        static qint64 cost(const QPixmap& pixmap);
+    };
+
+
+    // Owned by the application, must be used on the GUI thread
+    IconCache* iconCache();
+
+}
@@ -0,0 +1,229 @@
+#include "IconMask.hpp"
+
+#include "QFluentWidgets/common/VectorIcon.hpp"
+#include "QFluentWidgets/common/IconRasterizer.hpp"
+
+#include <QGuiApplication>
+#include <QPointer>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define QFLUENT_TINT_SSE2
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+#include <arm_neon.h>
+#define QFLUENT_TINT_NEON
+#endif
+
+namespace fluent {
+
+    // round(x * m / 255) without a division, exact for 8 bit inputs
+    static inline quint32 multiply255(quint32 x, quint32 m) {
+        quint32 t = x * m + 128;
+        return (t + (t >> 8)) >> 8;
+    }
+
+
+    static void tintScalar(const uchar* mask, quint32* dst, int count, QRgb color) {
+        const quint32 b = color & 0xff;
+        const quint32 g = (color >> 8) & 0xff;
+        const quint32 r = (color >> 16) & 0xff;
+        const quint32 a = color >> 24;
+
+        for (int i = 0; i < count; ++i) {
+            quint32 m = mask[i];
+            dst[i] = multiply255(a, m) << 24 | multiply255(r, m) << 16 | multiply255(g, m) << 8 | multiply255(b, m);
+        }
+    }
+
+
+#if defined(QFLUENT_TINT_SSE2)
+    static inline __m128i multiply255(__m128i x, __m128i color) {
+        __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, color), _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    }
+
+
+    void tintAlphaMask(const uchar* mask, quint32* dst, int count, QRgb color) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i color16 = _mm_unpacklo_epi8(_mm_set1_epi32(int(color)), zero);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+
+            // Every mask byte replicated over the four channels of its pixel
+            __m128i pairsLo = _mm_unpacklo_epi8(m, m);
+            __m128i pairsHi = _mm_unpackhi_epi8(m, m);
+            __m128i quads[4] = {
+                _mm_unpacklo_epi16(pairsLo, pairsLo),
+                _mm_unpackhi_epi16(pairsLo, pairsLo),
+                _mm_unpacklo_epi16(pairsHi, pairsHi),
+                _mm_unpackhi_epi16(pairsHi, pairsHi)
+            };
+
+            for (int q = 0; q < 4; ++q) {
+                __m128i lo = multiply255(_mm_unpacklo_epi8(quads[q], zero), color16);
+                __m128i hi = multiply255(_mm_unpackhi_epi8(quads[q], zero), color16);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + q * 4), _mm_packus_epi16(lo, hi));
+            }
+        }
+
+        tintScalar(mask + i, dst + i, count - i, color);
+    }
+#elif defined(QFLUENT_TINT_NEON)
+    static inline uint8x8_t multiply255(uint8x8_t m, uint8x8_t channel) {
+        uint16x8_t x = vmull_u8(m, channel);
+        return vraddhn_u16(x, vrshrq_n_u16(x, 8));
+    }
+
+
+    void tintAlphaMask(const uchar* mask, quint32* dst, int count, QRgb color) {
+        const uint8x8_t b = vdup_n_u8(color & 0xff);
+        const uint8x8_t g = vdup_n_u8((color >> 8) & 0xff);
+        const uint8x8_t r = vdup_n_u8((color >> 16) & 0xff);
+        const uint8x8_t a = vdup_n_u8(color >> 24);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            uint8x8_t m = vld1_u8(mask + i);
+            uint8x8x4_t pixels;
+            pixels.val[0] = multiply255(m, b);
+            pixels.val[1] = multiply255(m, g);
+            pixels.val[2] = multiply255(m, r);
+            pixels.val[3] = multiply255(m, a);
+            vst4_u8(reinterpret_cast<uint8_t*>(dst + i), pixels);
+        }
+
+        tintScalar(mask + i, dst + i, count - i, color);
+    }
+#else
+    void tintAlphaMask(const uchar* mask, quint32* dst, int count, QRgb color) {
+        tintScalar(mask, dst, count, color);
+    }
+#endif
+
+
+    IconMaskCache::IconMaskCache(QObject* parent)
+        : QObject(parent), hits(0), misses(0)
+    {
+        bool ok = false;
+        int megabytes = qEnvironmentVariableIntValue("QFLUENT_ICON_MASK_MB", &ok);
+        setMaxBytes(qint64(ok ? qMax(0, megabytes) : 2) * 1024 * 1024);
+    }
+
+
+    QImage IconMaskCache::mask(int vectorIndex, const QSize& size, qreal dpr) {
+        Key key{ vectorIndex, size, dpr };
+        if (const QImage* cached = cache.object(key)) {
+            ++hits;
+            return *cached;
+        }
+        ++misses;
+
+        QImage image = renderMask(vectorIndex, size, dpr);
+        cache.insert(key, new QImage(image), image.sizeInBytes());
+        return image;
+    }
+
+
+    void IconMaskCache::prefetch(int vectorIndex, const QSize& size, qreal dpr) {
+        Key key{ vectorIndex, size, dpr };
+        if (cache.contains(key)) {
+            return;
+        }
+
+        IconCacheKey id;
+        id.icon = "mask:" + VectorIcon::name(vectorIndex);
+        id.size = size;
+        id.dpr = dpr;
+
+        QPointer<IconMaskCache> masks(this);
+        iconRasterizer()->request(id,
+            [vectorIndex, size, dpr] { return renderMask(vectorIndex, size, dpr); },
+            [masks, key](const QImage& image) {
+                if (masks && !masks->cache.contains(key)) {
+                    masks->cache.insert(key, new QImage(image), image.sizeInBytes());
+                }
+            });
+    }
+
+
+    QImage IconMaskCache::renderMask(int vectorIndex, const QSize& size, qreal dpr) {
+        QImage image(size * dpr, QImage::Format_Alpha8);
+        image.setDevicePixelRatio(dpr);
+        image.fill(0);
+
+        QPainter painter(&image);
+        VectorIcon::paint(&painter, QRectF(QPointF(0, 0), QSizeF(size)), vectorIndex, Qt::black);
+        painter.end();
+        return image;
+    }
+
+
+    static QRgb premultipliedTint(const QColor& color, qreal opacity) {
+        QColor tint = color;
+        tint.setAlphaF(tint.alphaF() * opacity);
+        return qPremultiply(tint.rgba());
+    }
+
+
+    QImage IconMaskCache::tinted(int vectorIndex, const QSize& size, qreal dpr, const QColor& color, qreal opacity) {
+        QImage alpha = mask(vectorIndex, size, dpr);
+        QImage image(alpha.size(), QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(dpr);
+
+        QRgb premultiplied = premultipliedTint(color, opacity);
+        for (int y = 0; y < alpha.height(); ++y) {
+            tintAlphaMask(alpha.constScanLine(y), reinterpret_cast<quint32*>(image.scanLine(y)), alpha.width(), premultiplied);
+        }
+        return image;
+    }
+
+
+    void IconMaskCache::paint(QPainter* painter, const QRect& rect, int vectorIndex, const QColor& color, qreal opacity) {
+        qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : qApp->devicePixelRatio();
+        TintKey key{ { vectorIndex, rect.size(), dpr }, premultipliedTint(color, opacity) };
+
+        if (const QPixmap* cached = tints.object(key)) {
+            painter->drawPixmap(rect, *cached);
+            return;
+        }
+
+        QPixmap pixmap = QPixmap::fromImage(tinted(vectorIndex, rect.size(), dpr, color, opacity), Qt::NoFormatConversion);
+        painter->drawPixmap(rect, pixmap);
+        tints.insert(key, new QPixmap(pixmap), qint64(pixmap.width()) * pixmap.height() * 4);
+    }
+
+
+    void IconMaskCache::setMaxBytes(qint64 bytes) {
+        cache.setMaxCost(qMax<qint64>(0, bytes));
+        tints.setMaxCost(qMax<qint64>(0, bytes));
+    }
+
+
+    IconMaskStats IconMaskCache::stats() const {
+        IconMaskStats stats;
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.count = cache.count();
+        stats.bytes = cache.totalCost();
+        stats.maxBytes = cache.maxCost();
+        return stats;
+    }
+
+
+    void IconMaskCache::clear() {
+        cache.clear();
+        tints.clear();
+    }
+
+
+    IconMaskCache* iconMasks() {
+        static QPointer<IconMaskCache> masks;
+        if (!masks) {
+            masks = new IconMaskCache(QCoreApplication::instance());
+        }
+        return masks;
+    }
+
+}
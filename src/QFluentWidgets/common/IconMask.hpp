@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QObject>
+#include <QCache>
+#include <QImage>
+#include <QPixmap>
+#include <QPainter>
+#include <QColor>
+#include <QSize>
+#include <QRect>
+
+namespace fluent {
+
+    // Writes color (premultiplied ARGB32) scaled by every mask byte to dst.
+    // SSE2 or NEON when the target has it, the results are identical to the
+    // scalar loop.
+    void tintAlphaMask(const uchar* mask, quint32* dst, int count, QRgb premultipliedColor);
+
+
+    struct IconMaskStats {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        int count = 0;
+        qint64 bytes = 0;
+        qint64 maxBytes = 0;
+    };
+
+
+    // Coverage masks (Alpha8) of the compiled vector icons, one per size and
+    // device pixel ratio. Any tint, including the theme colors and the
+    // disabled opacity, is produced from the mask when painting, so theme and
+    // accent changes rasterize nothing. The tinted pixmaps painted are kept
+    // too, so a repaint is one lookup. Masks and tints each have a budget of
+    // 2 MB by default, QFLUENT_ICON_MASK_MB changes both.
+    class IconMaskCache : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit IconMaskCache(QObject* parent = nullptr);
+
+        QImage mask(int vectorIndex, const QSize& size, qreal dpr);
+        void prefetch(int vectorIndex, const QSize& size, qreal dpr);
+        QImage tinted(int vectorIndex, const QSize& size, qreal dpr, const QColor& color, qreal opacity = 1.0);
+        void paint(QPainter* painter, const QRect& rect, int vectorIndex, const QColor& color, qreal opacity = 1.0);
+
+        qint64 maxBytes() const { return cache.maxCost(); }
+        void setMaxBytes(qint64 bytes);
+
+        IconMaskStats stats() const;
+        void clear();
+
+    private:
+        struct Key {
+            int index;
+            QSize size;
+            qreal dpr;
+
+            bool operator==(const Key& other) const {
+                return index == other.index && size == other.size && dpr == other.dpr;
+            }
+        };
+
+        friend size_t qHash(const Key& key, size_t seed) {
+            return qHashMulti(seed, key.index, key.size.width(), key.size.height(), key.dpr);
+        }
+
+        // color is premultiplied with the opacity applied
+        struct TintKey {
+            Key mask;
+            QRgb color;
+
+            bool operator==(const TintKey& other) const {
+                return mask == other.mask && color == other.color;
+            }
+        };
+
+        friend size_t qHash(const TintKey& key, size_t seed) {
+            return qHashMulti(seed, key.mask, key.color);
+        }
+
+        QCache<Key, QImage> cache;
+        QCache<TintKey, QPixmap> tints;
+        qint64 hits;
+        qint64 misses;
+
+        // Thread-safe, used by prefetch on the rasterizer's workers
+        static QImage renderMask(int vectorIndex, const QSize& size, qreal dpr);
+    };
+
+
+    // Owned by the application, must be used on the GUI thread
+    IconMaskCache* iconMasks();
+
+}
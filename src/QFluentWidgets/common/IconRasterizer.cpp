@@ -0,0 +1,103 @@
+#include "IconRasterizer.hpp"
+
+#include <QCoreApplication>
+#include <QBackingStore>
+#include <QPaintEngine>
+#include <QThread>
+
+namespace fluent {
+
+    IconRasterizer::IconRasterizer(QObject* parent)
+        : QObject(parent), enabled(qEnvironmentVariable("QFLUENT_ICON_ASYNC") != "0")
+    {
+        // Leave cores to the GUI thread and the rest of the application
+        pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+    }
+
+
+    IconRasterizer::~IconRasterizer() {
+        pool.waitForDone();
+    }
+
+
+    void IconRasterizer::request(const IconCacheKey& key, Render render, Deliver deliver, QWidget* requester) {
+        if (failed.contains(key)) {
+            return;
+        }
+
+        auto it = pending.find(key);
+        if (it != pending.end()) {
+            if (requester && !it->requesters.contains(requester)) {
+                it->requesters.append(requester);
+            }
+            return;
+        }
+
+        Job job;
+        job.deliver = std::move(deliver);
+        if (requester) {
+            job.requesters.append(requester);
+        }
+        pending.insert(key, job);
+
+        pool.start([this, key, render = std::move(render)] {
+            QImage image = render();
+            QMetaObject::invokeMethod(this, [this, key, image] { finish(key, image); }, Qt::QueuedConnection);
+        });
+    }
+
+
+    QWidget* IconRasterizer::deferrableWidget(QPainter* painter) const {
+        if (!enabled || !painter || !painter->paintEngine()) {
+            return nullptr;
+        }
+
+        auto* widget = dynamic_cast<QWidget*>(painter->device());
+        if (!widget) {
+            return nullptr;
+        }
+
+        // painter->device() is the widget in both cases, only the engine
+        // tells the backing store from a grab() pixmap
+        QBackingStore* store = widget->window()->backingStore();
+        return store && painter->paintEngine()->paintDevice() == store->paintDevice() ? widget : nullptr;
+    }
+
+
+    bool IconRasterizer::waitForDone(int msecs) {
+        return pool.waitForDone(msecs);
+    }
+
+
+    void IconRasterizer::finish(const IconCacheKey& key, const QImage& image) {
+        Job job = pending.take(key);
+
+        // Not retried, otherwise the repaint would request it again forever
+        if (image.isNull()) {
+            failed.insert(key);
+            emit rasterized(pending.size());
+            return;
+        }
+
+        if (job.deliver) {
+            job.deliver(image);
+        }
+
+        for (const auto& widget : job.requesters) {
+            if (widget) {
+                widget->update();
+            }
+        }
+        emit rasterized(pending.size());
+    }
+
+
+    IconRasterizer* iconRasterizer() {
+        static QPointer<IconRasterizer> rasterizer;
+        if (!rasterizer) {
+            rasterizer = new IconRasterizer(QCoreApplication::instance());
+        }
+        return rasterizer;
+    }
+
+}
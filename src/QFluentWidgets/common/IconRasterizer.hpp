@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QObject>
+#include <QWidget>
+#include <QPointer>
+#include <QImage>
+#include <QPainter>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QThreadPool>
+#include <functional>
+
+#include "QFluentWidgets/common/IconCache.hpp"
+
+namespace fluent {
+
+    // Renders icon rasters on worker threads. render() runs on the pool and
+    // must only use thread-safe code (QImage, QPainter on it, QSvgRenderer),
+    // deliver() runs on the GUI thread when the image is ready, after which
+    // every widget that asked for it is repainted. Requests for a key that
+    // is already being rendered are merged, a null image marks the key as
+    // failed and it is not requested again. QFLUENT_ICON_ASYNC=0 makes
+    // callers render synchronously.
+    class IconRasterizer : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        using Render = std::function<QImage()>;
+        using Deliver = std::function<void(const QImage&)>;
+
+        explicit IconRasterizer(QObject* parent = nullptr);
+        ~IconRasterizer();
+
+        void request(const IconCacheKey& key, Render render, Deliver deliver, QWidget* requester = nullptr);
+
+        bool isPending(const IconCacheKey& key) const { return pending.contains(key); }
+        int pendingCount() const { return pending.size(); }
+
+        bool isEnabled() const { return enabled; }
+        void setEnabled(bool enabled) { this->enabled = enabled; }
+
+        // The widget painter paints into its window's backing store, which can
+        // wait for a repaint. Null for grab(), render() and any other paint
+        // that needs the raster now, or when disabled.
+        QWidget* deferrableWidget(QPainter* painter) const;
+
+        // Blocks until the running jobs are done, their results are delivered
+        // by the event loop as usual
+        bool waitForDone(int msecs = -1);
+
+    signals:
+        void rasterized(int remaining);
+
+    private:
+        struct Job {
+            Deliver deliver;
+            QList<QPointer<QWidget>> requesters;
+        };
+
+        QThreadPool pool;
+        QHash<IconCacheKey, Job> pending;
+        QSet<IconCacheKey> failed;
+        bool enabled;
+
+        void finish(const IconCacheKey& key, const QImage& image);
+    };
+
+
+    // Owned by the application, must be used on the GUI thread
+    IconRasterizer* iconRasterizer();
+
+}
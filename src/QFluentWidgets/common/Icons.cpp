@@ -1,17 +1,94 @@
 #include "Icons.hpp"
 
-#include "QFluentWidgets/utils/os.hpp"
+#include "QFluentWidgets/common/ThemeState.hpp"
+#include "QFluentWidgets/common/IconCache.hpp"
+#include "QFluentWidgets/common/IconAtlas.hpp"
+#include "QFluentWidgets/common/SvgTemplate.hpp"
+#include "QFluentWidgets/common/IconMask.hpp"
+#include "QFluentWidgets/common/IconRasterizer.hpp"
 
 #include <QIcon>
+#include <QHash>
+#include <QSet>
+#include <QReadWriteLock>
+#include <array>
 
 namespace fluent {
 
+    // Raw svg files from the resources, read (and decompressed) only once
+    static QReadWriteLock svgCacheLock;
+    static QHash<QString, QByteArray> svgCache;
+
+
+    static qreal modeOpacity(QIcon::Mode mode) {
+        switch (mode) {
+        case QIcon::Disabled: return 0.5;
+        case QIcon::Selected: return 0.7;
+        default:              return 1.0;
+        }
+    }
+
+
+    // Thread-safe, also runs on the rasterizer's workers
+    static QImage rasterizeSvg(const QByteArray& source, const QSize& size, qreal dpr, qreal opacity) {
+        QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(dpr);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        painter.setOpacity(opacity);
+        QSvgRenderer renderer(source);
+        renderer.render(&painter, QRectF(QPointF(0, 0), QSizeF(size)));
+        painter.end();
+        return image;
+    }
+
+
+    // Keys the rasterizer already delivered. One that is missing from the
+    // cache again was dropped or evicted, it is rendered on the spot rather
+    // than requested and repainted in a loop. GUI thread only.
+    static QSet<IconCacheKey> deliveredRasters;
+
+
+    static void storeDelivered(const IconCacheKey& key, const QImage& image) {
+        // Only a bound on memory, the worst case is one more async round
+        if (deliveredRasters.size() >= 4096) {
+            deliveredRasters.clear();
+        }
+        deliveredRasters.insert(key);
+        iconCache()->insert(key, QPixmap::fromImage(image, Qt::NoFormatConversion));
+    }
+
+
+    // Cached raster for key. When painting a widget on screen a missing raster
+    // is rendered in the background and the widget repainted once it is there,
+    // the null pixmap returned meanwhile is the placeholder.
+    static QPixmap cachedRaster(QPainter* painter, const IconCacheKey& key, IconRasterizer::Render render) {
+        QPixmap pixmap;
+        if (iconCache()->find(key, &pixmap)) {
+            return pixmap;
+        }
+
+        QWidget* widget = iconRasterizer()->deferrableWidget(painter);
+        if (widget && !deliveredRasters.contains(key)) {
+            iconRasterizer()->request(key, std::move(render), [key](const QImage& image) {
+                storeDelivered(key, image);
+            }, widget);
+            return pixmap;
+        }
+
+        pixmap = QPixmap::fromImage(render(), Qt::NoFormatConversion);
+        iconCache()->insert(key, pixmap);
+        return pixmap;
+    }
+
+
     QString getIconColor(Theme::Mode theme, bool reverse) {
         QString lc = reverse ? "white" : "black";
         QString dc = reverse ? "black" : "white";
 
         if (theme == Theme::Mode::Auto) {
-            return os::isDarkTheme() ? dc : lc;
+            return themeState()->isDarkTheme() ? dc : lc;
         }
         else {
             return (theme == Theme::Mode::Dark) ? dc : lc;
@@ -19,6 +96,29 @@ namespace fluent {
     }
 
 
+    QByteArray svgSource(const QString& iconPath) {
+        {
+            QReadLocker locker(&svgCacheLock);
+            auto it = svgCache.constFind(iconPath);
+            if (it != svgCache.cend()) {
+                return *it;
+            }
+        }
+
+        QFile file(iconPath);
+        if (!file.open(QFile::ReadOnly)) {
+            return QByteArray();
+        }
+        QByteArray source = file.readAll();
+
+        if (iconPath.startsWith(':')) {
+            QWriteLocker locker(&svgCacheLock);
+            svgCache.insert(iconPath, source);
+        }
+        return source;
+    }
+
+
     void drawSvgIcon(
         const QString& icon,
         QPainter* painter,
@@ -38,28 +138,12 @@ namespace fluent {
             return "";
         }
 
-        QFile file(iconPath);
-        if (!file.open(QFile::ReadOnly)) {
+        SvgTemplate svgTemplate = SvgTemplate::fromFile(iconPath);
+        if (!svgTemplate.isValid()) {
             return "";
         }
 
-        QDomDocument dom;
-        if (!dom.setContent(&file)) {
-            file.close();
-            return "";
-        }
-        file.close();
-
-        QDomNodeList pathNodes = dom.elementsByTagName("path");
-        QList<int> indices = indexes.isEmpty() ? QList<int>(pathNodes.count(), 0) : indexes;
-        for (int i = 0; i < indices.size(); ++i) {
-            QDomElement element = pathNodes.at(indices.at(i)).toElement();
-            for (auto it = attributes.begin(); it != attributes.end(); ++it) {
-                element.setAttribute(it.key(), it.value());
-            }
-        }
-
-        return dom.toString();
+        return QString::fromUtf8(svgTemplate.apply(indexes, attributes));
     }
 
 
@@ -74,6 +158,11 @@ namespace fluent {
 
 
     QIcon FluentIconBase::icon(Theme::Mode theme, const QColor& color) const {
+        int vector = vectorIndex();
+        if (vector >= 0) {
+            return QIcon(new VectorIconEngine(vector, color.isValid() ? color : QColor(getIconColor(theme))));
+        }
+
         QString iconPath = path(theme);
         if (!iconPath.endsWith(".svg") || !color.isValid()) {
             return QIcon(iconPath);
@@ -96,12 +185,24 @@ namespace fluent {
         const QList<int>& indexes,
         const QMap<QString, QString>& attributes
     ) const {
+        // Compiled icons never touch the svg, a recolor of the whole icon is
+        // just a different brush
+        int vector = vectorIndex();
+        bool fillOnly = attributes.isEmpty() || (attributes.size() == 1 && attributes.contains("fill"));
+        if (vector >= 0 && indexes.isEmpty() && fillOnly) {
+            QColor color(attributes.isEmpty() ? getIconColor(theme) : attributes.value("fill"));
+            iconMasks()->paint(painter, rect, vector, color);
+            return;
+        }
+
         QString iconPath = path(theme);
+        if (attributes.isEmpty() && iconAtlas()->draw(painter, rect, iconPath)) {
+            return;
+        }
+
         if (iconPath.endsWith(".svg")) {
-            if (!attributes.isEmpty()) {
-                iconPath = writeSvg(iconPath, indexes, attributes).toUtf8();
-            }
-            drawSvgIcon(iconPath, painter, rect);
+            QString svg = attributes.isEmpty() ? QString::fromUtf8(svgSource(iconPath)) : writeSvg(iconPath, indexes, attributes);
+            drawSvgIcon(svg, painter, rect);
         }
         else {
             QIcon icon(iconPath);
@@ -127,34 +228,35 @@ namespace fluent {
         QIcon::Mode mode,
         QIcon::State state
     ) {
-        painter->save();
-
-        if (mode == QIcon::Disabled) {
-            painter->setOpacity(0.5);
-        }
-        else if (mode == QIcon::Selected) {
-            painter->setOpacity(0.7);
+        QRect adjustedRect = rect;
+        if (rect.x() == 19) {
+            adjustedRect.adjust(-1, 0, 0, 0);
         }
 
-        QIcon finalIcon = icon;
-
-        Theme::Mode theme = isThemeReversed ? (isDarkTheme() ? Theme::Mode::Light : Theme::Mode::Dark) : Theme::Mode::Auto;
-
-        // 如果icon是 FluentIconBase 的实例，调用icon方法
-        //TODO test it
         if (ficon != nullptr) {
-            finalIcon = ficon->icon(theme);
-        }
-        // if (auto fluentIcon = dynamic_cast<FluentIconBase*>(icon); fluentIcon != nullptr) {
-        //     finalIcon = fluentIcon->icon(theme);
-        // }
+            Theme::Mode theme = resolvedTheme();
+            if (int vector = ficon->vectorIndex(); vector >= 0) {
+                iconMasks()->paint(painter, adjustedRect, vector, QColor(getIconColor(theme)), modeOpacity(mode));
+                return;
+            }
 
-        QRect adjustedRect = rect;
-        if (rect.x() == 19) {
-            adjustedRect.adjust(-1, 0, 0, 0);
+            QString iconPath = ficon->path(theme);
+            if (iconAtlas()->draw(painter, adjustedRect, iconPath, modeOpacity(mode))) {
+                return;
+            }
+
+            qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : qApp->devicePixelRatio();
+            QPixmap pixmap = cachedPixmap(painter, iconPath, theme, adjustedRect.size(), dpr, mode, state);
+            if (!pixmap.isNull()) {
+                painter->drawPixmap(adjustedRect, pixmap);
+            }
+            return;
         }
 
-        finalIcon.paint(painter, adjustedRect, Qt::AlignCenter, mode, state);
+        // A plain QIcon keeps its own pixmap cache
+        painter->save();
+        painter->setOpacity(painter->opacity() * modeOpacity(mode));
+        icon.paint(painter, adjustedRect, Qt::AlignCenter, mode, state);
         painter->restore();
     }
 
@@ -169,6 +271,15 @@ namespace fluent {
         QIcon::Mode mode,
         QIcon::State state
     ) {
+        if (ficon != nullptr) {
+            Theme::Mode theme = resolvedTheme();
+            if (int vector = ficon->vectorIndex(); vector >= 0) {
+                QImage image = iconMasks()->tinted(vector, size, 1.0, QColor(getIconColor(theme)), modeOpacity(mode));
+                return QPixmap::fromImage(std::move(image), Qt::NoFormatConversion);
+            }
+            return cachedPixmap(nullptr, ficon->path(theme), theme, size, 1.0, mode, state);
+        }
+
         QImage image(size, QImage::Format_ARGB32);
         image.fill(Qt::transparent);
         QPixmap pixmap = QPixmap::fromImage(image, Qt::NoFormatConversion);
@@ -180,9 +291,44 @@ namespace fluent {
     }
 
 
+    QPixmap FluentIconEngine::cachedPixmap(
+        QPainter* painter,
+        const QString& iconPath,
+        Theme::Mode theme,
+        const QSize& size,
+        qreal dpr,
+        QIcon::Mode mode,
+        QIcon::State state
+    ) const {
+        IconCacheKey key;
+        key.icon = iconPath;
+        key.theme = theme;
+        key.size = size;
+        key.dpr = dpr;
+        key.mode = mode;
+        key.state = state;
+
+        // QIcon and QPixmap are GUI thread only, other formats stay synchronous
+        if (!iconPath.endsWith(".svg")) {
+            return iconCache()->pixmap(key, [&] {
+                return QIcon(iconPath).pixmap(size, dpr, mode, state);
+            });
+        }
+
+        qreal opacity = modeOpacity(mode);
+        return cachedRaster(painter, key, [iconPath, size, dpr, opacity] {
+            return rasterizeSvg(svgSource(iconPath), size, dpr, opacity);
+        });
+    }
+
+
     bool FluentIconEngine::isDarkTheme() const {
-        // 替换为实际的主题检查逻辑
-        return os::isDarkTheme();
+        return themeState()->isDarkTheme();
+    }
+
+
+    Theme::Mode FluentIconEngine::resolvedTheme() const {
+        return isDarkTheme() != isThemeReversed ? Theme::Mode::Dark : Theme::Mode::Light;
     }
 
 
@@ -198,7 +344,11 @@ namespace fluent {
         QIcon::Mode mode,
         QIcon::State state
     ) {
-        drawSvgIcon(svg, painter, rect);
+        qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : qApp->devicePixelRatio();
+        QPixmap pixmap = cachedPixmap(painter, rect.size(), dpr);
+        if (!pixmap.isNull()) {
+            painter->drawPixmap(rect, pixmap);
+        }
     }
 
 
@@ -212,14 +362,51 @@ namespace fluent {
         QIcon::Mode mode,
         QIcon::State state
     ) {
-        QImage image(size, QImage::Format_ARGB32);
-        image.fill(Qt::transparent);
-        QPixmap pixmap = QPixmap::fromImage(image, Qt::NoFormatConversion);
+        return cachedPixmap(nullptr, size, 1.0);
+    }
 
-        QPainter painter(&pixmap);
-        QRect rect(0, 0, size.width(), size.height());
-        this->paint(&painter, rect, mode, state);
-        return pixmap;
+
+    QPixmap SvgIconEngine::cachedPixmap(QPainter* painter, const QSize& size, qreal dpr) const {
+        // The svg text itself is the identity, shared rather than copied
+        IconCacheKey key;
+        key.icon = svg;
+        key.size = size;
+        key.dpr = dpr;
+
+        QString source = svg;
+        return cachedRaster(painter, key, [source, size, dpr] {
+            return rasterizeSvg(source.toUtf8(), size, dpr, 1.0);
+        });
+    }
+
+
+
+    VectorIconEngine::VectorIconEngine(int index, const QColor& color)
+        : index(index), color(color)
+    {}
+
+
+    void VectorIconEngine::paint(
+        QPainter* painter,
+        const QRect& rect,
+        QIcon::Mode mode,
+        QIcon::State state
+    ) {
+        iconMasks()->paint(painter, rect, index, color, modeOpacity(mode));
+    }
+
+
+    QIconEngine* VectorIconEngine::clone() const {
+        return new VectorIconEngine(*this);
+    }
+
+
+    QPixmap VectorIconEngine::pixmap(
+        const QSize& size,
+        QIcon::Mode mode,
+        QIcon::State state
+    ) {
+        return QPixmap::fromImage(iconMasks()->tinted(index, size, 1.0, color, modeOpacity(mode)), Qt::NoFormatConversion);
     }
 
 
@@ -229,60 +416,88 @@ namespace fluent {
     {}
 
 
+    // Resource paths of every icon, built once: [dark][type]
+    static const std::array<std::array<QString, FluentIcon::Nil>, 2>& iconPaths() {
+        static const auto paths = [] {
+            std::array<std::array<QString, FluentIcon::Nil>, 2> result;
+            for (int i = 0; i < FluentIcon::Nil; ++i) {
+                QString name = QString::fromLatin1(icondata::iconNames[i]);
+                result[0][i] = QString(":/qfluentwidgets/images/icons/%1_black.svg").arg(name);
+                result[1][i] = QString(":/qfluentwidgets/images/icons/%1_white.svg").arg(name);
+            }
+            return result;
+        }();
+        return paths;
+    }
+
+
     QString FluentIcon::path(Theme::Mode theme) const {
-        return QString(":/qfluentwidgets/images/icons/%1_%2.svg").arg(iconTypeToString(type)).arg(getIconColor(theme));
+        if (type < 0 || type >= Nil) {
+            return QString();
+        }
+
+        bool dark = theme == Theme::Mode::Auto ? themeState()->isDarkTheme() : theme == Theme::Mode::Dark;
+        return iconPaths()[dark][type];
     }
 
 
     QString FluentIcon::iconTypeToString(IconType type) {
-        static QMap<IconType, QString> iconTypeMap = {
-            {Up, "Up"}, {Add, "Add"}, {Bus, "Bus"}, {Car, "Car"},
-            {Cut, "Cut"}, {IOT, "IOT"}, {Pin, "Pin"}, {Tag, "Tag"},
-            {VPN, "VPN"}, {Cafe, "Cafe"}, {Chat, "Chat"}, {Copy, "Copy"},
-            {Code, "Code"}, {Down, "Down"}, {Edit, "Edit"}, {Flag, "Flag"},
-            {Font, "Font"}, {Game, "Game"}, {Help, "Help"}, {Hide, "Hide"},
-            {Home, "Home"}, {Info, "Info"}, {Leaf, "Leaf"}, {Link, "Link"},
-            {Mail, "Mail"}, {Menu, "Menu"}, {Mute, "Mute"}, {More, "More"},
-            {Move, "Move"}, {Play, "Play"}, {Save, "Save"}, {Send, "Send"},
-            {Sync, "Sync"}, {Unit, "Unit"}, {View, "View"}, {Wifi, "Wifi"},
-            {Zoom, "Zoom"}, {Album, "Album"}, {Brush, "Brush"}, {Broom, "Broom"},
-            {Close, "Close"}, {Cloud, "Cloud"}, {Embed, "Embed"}, {Globe, "Globe"},
-            {Heart, "Heart"}, {Label, "Label"}, {Media, "Media"}, {Movie, "Movie"},
-            {Music, "Music"}, {Robot, "Robot"}, {Pause, "Pause"}, {Paste, "Paste"},
-            {Photo, "Photo"}, {Phone, "Phone"}, {Print, "Print"}, {Share, "Share"},
-            {Tiles, "Tiles"}, {Unpin, "Unpin"}, {Video, "Video"}, {Train, "Train"},
-            {AddTo, "AddTo"}, {Accept, "Accept"}, {Camera, "Camera"}, {Cancel, "Cancel"},
-            {Delete, "Delete"}, {Folder, "Folder"}, {Filter, "Filter"}, {Market, "Market"},
-            {Scroll, "Scroll"}, {Layout, "Layout"}, {GitHub, "GitHub"}, {Update, "Update"},
-            {Remove, "Remove"}, {Return, "Return"}, {People, "People"}, {QRCode, "QRCode"},
-            {Ringer, "Ringer"}, {Rotate, "Rotate"}, {Search, "Search"}, {Volume, "Volume"},
-            {Frigid, "Frigid"}, {SaveAs, "SaveAs"}, {ZoomIn, "ZoomIn"}, {Connect, "Connect"},
-            {History, "History"}, {Setting, "Setting"}, {Palette, "Palette"}, {Message, "Message"},
-            {FitPage, "FitPage"}, {ZoomOut, "ZoomOut"}, {Airplane, "Airplane"}, {Asterisk, "Asterisk"},
-            {Calories, "Calories"}, {Calendar, "Calendar"}, {Feedback, "Feedback"}, {Library, "Library"},
-            {Minimize, "Minimize"}, {CheckBox, "CheckBox"}, {Document, "Document"}, {Language, "Language"},
-            {Download, "Download"}, {Question, "Question"}, {Speakers, "Speakers"}, {DateTime, "DateTime"},
-            {FontSize, "FontSize"}, {HomeFill, "HomeFill"}, {PageLeft, "PageLeft"}, {SaveCopy, "SaveCopy"},
-            {SendFill, "SendFill"}, {SkipBack, "SkipBack"}, {SpeedOff, "SpeedOff"}, {Alignment, "Alignment"},
-            {Bluetooth, "Bluetooth"}, {Completed, "Completed"}, {Constract, "Constract"}, {Headphone, "Headphone"},
-            {Megaphone, "Megaphone"}, {Projector, "Projector"}, {Education, "Education"}, {LeftArrow, "LeftArrow"},
-            {EraseTool, "EraseTool"}, {PageRight, "PageRight"}, {PlaySolid, "PlaySolid"}, {BookShelf, "BookShelf"},
-            {Highlight, "Highlight"}, {FolderAdd, "FolderAdd"}, {PauseBold, "PauseBold"}, {PencilInk, "PencilInk"},
-            {PieSingle, "PieSingle"}, {QuickNote, "QuickNote"}, {SpeedHigh, "SpeedHigh"}, {StopWatch, "StopWatch"},
-            {ZipFolder, "ZipFolder"}, {Basketball, "Basketball"}, {Brightness, "Brightness"}, {Dictionary, "Dictionary"},
-            {Microphone, "Microphone"}, {ArrowDown, "ArrowDown"}, {FullScreen, "FullScreen"}, {MixVolumes, "MixVolumes"},
-            {RemoveFrom, "RemoveFrom"}, {RightArrow, "RightArrow"}, {QuietHours, "QuietHours"}, {Fingerprint, "Fingerprint"},
-            {Application, "Application"}, {Certificate, "Certificate"}, {Transparent, "Transparent"}, {ImageExport, "ImageExport"},
-            {SpeedMedium, "SpeedMedium"}, {LibraryFill, "LibraryFill"}, {MusicFolder, "MusicFolder"}, {PowerButton, "PowerButton"},
-            {SkipForward, "SkipForward"}, {CareUpSolid, "CareUpSolid"}, {AcceptMedium, "AcceptMedium"}, {CancelMedium, "CancelMedium"},
-            {ChevronRight, "ChevronRight"}, {ClippingTool, "ClippingTool"}, {SearchMirror, "SearchMirror"}, {ShoppingCart, "ShoppingCart"},
-            {FontIncrease, "FontIncrease"}, {BackToWindow, "BackToWindow"}, {CommandPrompt, "CommandPrompt"}, {CloudDownload, "CloudDownload"},
-            {DictionaryAdd, "DictionaryAdd"}, {CareDownSolid, "CareDownSolid"}, {CareLeftSolid, "CareLeftSolid"}, {ClearSelection, "ClearSelection"},
-            {DeveloperTools, "DeveloperTools"}, {BackgroundColor, "BackgroundColor"}, {CareRightSolid, "CareRightSolid"}, {ChevronDownMed, "ChevronDownMed"},
-            {ChevronRightMed, "ChevronRightMed"}, {EmojiTabSymbols, "EmojiTabSymbols"}, {ExpressiveInputEntry, "ExpressiveInputEntry"}
-        };
-
-        return iconTypeMap.value(type);
+        return type >= 0 && type < Nil ? QString::fromLatin1(icondata::iconNames[type]) : QString();
+    }
+
+
+    void prefetchIcon(const FluentIconBase& icon, const QList<QSize>& sizes, Theme::Mode theme) {
+        if (theme == Theme::Mode::Auto) {
+            theme = themeState()->isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light;
+        }
+
+        // The same route and keys FluentIconEngine::paint uses
+        qreal dpr = qApp->devicePixelRatio();
+        QString iconPath = icon.path(theme);
+        int vector = icon.vectorIndex();
+        bool svg = iconPath.endsWith(".svg");
+
+        for (const QSize& size : sizes) {
+            if (vector >= 0) {
+                iconMasks()->prefetch(vector, size, dpr);
+            }
+            else if (svg && iconAtlas()->isEnabled() && IconAtlas::supports(size, dpr)) {
+                iconAtlas()->prefetch(iconPath, qRound(size.width() * dpr));
+            }
+            else if (svg) {
+                IconCacheKey key;
+                key.icon = iconPath;
+                key.theme = theme;
+                key.size = size;
+                key.dpr = dpr;
+
+                QPixmap pixmap;
+                if (iconCache()->find(key, &pixmap)) {
+                    continue;
+                }
+                iconRasterizer()->request(key,
+                    [iconPath, size, dpr] { return rasterizeSvg(svgSource(iconPath), size, dpr, 1.0); },
+                    [key](const QImage& image) { storeDelivered(key, image); });
+            }
+        }
+    }
+
+
+    void prefetchIcons(const QList<FluentIcon::IconType>& icons, const QList<QSize>& sizes, Theme::Mode theme) {
+        for (auto type : icons) {
+            prefetchIcon(FluentIcon(type), sizes, theme);
+        }
+    }
+
+
+    void preloadIcons(Theme::Mode theme) {
+        // Compiled icons are drawn without their svg
+        for (int i = 0; i < FluentIcon::Nil; ++i) {
+            FluentIcon icon(static_cast<FluentIcon::IconType>(i));
+            if (icon.vectorIndex() < 0) {
+                svgSource(icon.path(theme));
+            }
+        }
     }
 
 } // namespace fluent
\ No newline at end of file
@@ -5,7 +5,6 @@
 #include <QRect>
 #include <QSvgRenderer>
 #include <QFile>
-#include <QDomDocument>
 #include <QIcon>
 #include <QColor>
 #include <QImage>
@@ -14,10 +13,12 @@
 #include <QMap>
 
 #include "Config.hpp"
+#include "FluentIconTypes.hpp"
 
 namespace fluent {
 
     QString getIconColor(Theme::Mode theme = Theme::Mode::Auto, bool reverse = false);
+    QByteArray svgSource(const QString& iconPath);
     void drawSvgIcon(const QString& icon, QPainter* painter, const QRect& rect);
     QString writeSvg(const QString& iconPath, const QList<int>& indexes = {}, const QMap<QString, QString>& attributes = {});
     void drawIcon(QIcon& icon, QPainter* painter, QRectF rect, QIcon::State state = QIcon::Off);
@@ -27,6 +28,9 @@ namespace fluent {
     public:
         virtual QString path(Theme::Mode theme = Theme::Mode::Auto) const = 0;
 
+        // Index of the compiled vector icon, -1 to use the svg files
+        virtual int vectorIndex() const { return -1; }
+
         QIcon icon(Theme::Mode theme = Theme::Mode::Auto, const QColor& color = QColor()) const;
         QIcon qicon(bool reverse = false) const;
 
@@ -51,6 +55,8 @@ namespace fluent {
         bool isThemeReversed;
 
         bool isDarkTheme() const;
+        Theme::Mode resolvedTheme() const;
+        QPixmap cachedPixmap(QPainter* painter, const QString& iconPath, Theme::Mode theme, const QSize& size, qreal dpr, QIcon::Mode mode, QIcon::State state) const;
     };
 
 
@@ -65,18 +71,44 @@ namespace fluent {
 
     private:
         QString svg;
+
+        QPixmap cachedPixmap(QPainter* painter, const QSize& size, qreal dpr) const;
+    };
+
+
+    class VectorIconEngine : public QIconEngine
+    {
+    public:
+        VectorIconEngine(int index, const QColor& color);
+
+        void paint(QPainter* painter, const QRect& rect, QIcon::Mode mode, QIcon::State state) override;
+        QIconEngine* clone() const override;
+        QPixmap pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) override;
+
+    private:
+        int index;
+        QColor color;
     };
 
 
     class FluentIcon : public FluentIconBase {
     public:
+        // Generated from src/assets/images/icons by tools/IconCompiler, the
+        // values index the name, path and vector icon tables
         enum IconType {
-            Up, Add, Bus, Car, Cut, IOT, Pin, Tag, VPN, Cafe, Chat, Copy, Code, Down, Edit, Flag, Font, Game, Help, Hide, Home, Info, Leaf, Link, Mail, Menu, Mute, More, Move, Play, Save, Send, Sync, Unit, View, Wifi, Zoom, Album, Brush, Broom, Close, Cloud, Embed, Globe, Heart, Label, Media, Movie, Music, Robot, Pause, Paste, Photo, Phone, Print, Share, Tiles, Unpin, Video, Train, AddTo, Accept, Camera, Cancel, Delete, Folder, Filter, Market, Scroll, Layout, GitHub, Update, Remove, Return, People, QRCode, Ringer, Rotate, Search, Volume, Frigid, SaveAs, ZoomIn, Connect, History, Setting, Palette, Message, FitPage, ZoomOut, Airplane, Asterisk, Calories, Calendar, Feedback, Library, Minimize, CheckBox, Document, Language, Download, Question, Speakers, DateTime, FontSize, HomeFill, PageLeft, SaveCopy, SendFill, SkipBack, SpeedOff, Alignment, Bluetooth, Completed, Constract, Headphone, Megaphone, Projector, Education, LeftArrow, EraseTool, PageRight, PlaySolid, BookShelf, Highlight, FolderAdd, PauseBold, PencilInk, PieSingle, QuickNote, SpeedHigh, StopWatch, ZipFolder, Basketball, Brightness, Dictionary, Microphone, ArrowDown, FullScreen, MixVolumes, RemoveFrom, RightArrow, QuietHours, Fingerprint, Application, Certificate, Transparent, ImageExport, SpeedMedium, LibraryFill, MusicFolder, PowerButton, SkipForward, CareUpSolid, AcceptMedium, CancelMedium, ChevronRight, ClippingTool, SearchMirror, ShoppingCart, FontIncrease, BackToWindow, CommandPrompt, CloudDownload, DictionaryAdd, CareDownSolid, CareLeftSolid, ClearSelection, DeveloperTools, BackgroundColor, CareRightSolid, ChevronDownMed, ChevronRightMed, EmojiTabSymbols, ExpressiveInputEntry, Nil
+#define QFLUENT_ICON_TYPE(name) name,
+            QFLUENT_ICON_TYPES(QFLUENT_ICON_TYPE)
+#undef QFLUENT_ICON_TYPE
+            Nil,
+#define QFLUENT_ICON_ALIAS(alias, name) alias = name,
+            QFLUENT_ICON_ALIASES(QFLUENT_ICON_ALIAS)
+#undef QFLUENT_ICON_ALIAS
         };
 
         FluentIcon(IconType type);
 
         QString path(Theme::Mode theme = Theme::Mode::Auto) const override;
+        int vectorIndex() const override { return type < Nil ? type : -1; }
         IconType getType() { return type; }
         bool isNull() { return type == Nil; }
 
@@ -86,4 +118,12 @@ namespace fluent {
         static QString iconTypeToString(IconType type);
     };
 
+
+    // Rasterizes icons in the background before their first paint, e.g. for
+    // a page that is about to be shown. Must be called on the GUI thread.
+    void prefetchIcon(const FluentIconBase& icon, const QList<QSize>& sizes, Theme::Mode theme = Theme::Mode::Auto);
+    void prefetchIcons(const QList<FluentIcon::IconType>& icons, const QList<QSize>& sizes, Theme::Mode theme = Theme::Mode::Auto);
+
+    void preloadIcons(Theme::Mode theme);
+
 }
\ No newline at end of file
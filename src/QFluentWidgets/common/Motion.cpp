@@ -0,0 +1,39 @@
+#include "Motion.hpp"
+
+#include <utility>
+
+namespace fluent {
+
+    template <std::size_t... I>
+    static constexpr std::array<EasingTable, sizeof...(I)> buildTables(std::index_sequence<I...>) {
+        return {{ EasingTable(motion::presets[I])... }};
+    }
+
+
+    static constexpr auto easingTables = buildTables(std::make_index_sequence<motion::presets.size()>());
+
+
+    template <std::size_t I>
+    static qreal ease(qreal progress) {
+        return easingTables[I].value(progress);
+    }
+
+
+    template <std::size_t... I>
+    static constexpr std::array<QEasingCurve::EasingFunction, sizeof...(I)> buildFunctions(std::index_sequence<I...>) {
+        return {{ &ease<I>... }};
+    }
+
+
+    static constexpr auto easingFunctions = buildFunctions(std::make_index_sequence<motion::presets.size()>());
+
+
+    QEasingCurve motionCurve(int preset) {
+        QEasingCurve curve;
+        if (preset >= 0 && preset < int(easingFunctions.size())) {
+            curve.setCustomType(easingFunctions[preset]);
+        }
+        return curve;
+    }
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QEasingCurve>
+#include <array>
+
+namespace fluent {
+
+    // Fluent motion preset: cubic Bezier control points and the duration in
+    // ms for the FAST, MEDIUM and SLOW speeds
+    struct MotionPreset {
+        qreal x1;
+        qreal y1;
+        qreal x2;
+        qreal y2;
+        std::array<int, 3> durations;
+    };
+
+
+    namespace motion {
+
+        inline constexpr MotionPreset linear { 0, 0, 1, 1, { 100, 100, 100 } };
+
+        // Same order as FluentAnimationType
+        inline constexpr std::array<MotionPreset, 6> presets {{
+            { 0,    0,    0, 1,    { 187, 333, 500 } },  // FAST_INVOKE
+            { 0.13, 1.62, 0, 0.92, { 667, 667, 667 } },  // STRONG_INVOKE
+            { 0,    0,    0, 1,    { 187, 333, 500 } },  // FAST_DISMISS
+            { 1,    0,    1, 1,    { 167, 167, 167 } },  // SOFT_DISMISS
+            { 0.55, 0.55, 0, 1,    { 187, 333, 500 } },  // POINT_TO_POINT
+            { 0,    0,    1, 1,    { 83,  83,  83  } },  // FADE_IN_OUT
+        }};
+
+    }
+
+
+    // Bezier easing sampled at compile time on a uniform progress grid, so a
+    // tick is one lookup and one lerp instead of solving the cubic
+    class EasingTable
+    {
+    public:
+        static constexpr int Size = 256;
+
+        constexpr EasingTable(const MotionPreset& preset)
+            : samples{}
+        {
+            for (int i = 0; i <= Size; ++i) {
+                qreal x = qreal(i) / Size;
+                samples[i] = float(bezier(preset.y1, preset.y2, solve(preset.x1, preset.x2, x)));
+            }
+        }
+
+        constexpr qreal value(qreal progress) const {
+            if (progress <= 0) {
+                return samples[0];
+            }
+            if (progress >= 1) {
+                return samples[Size];
+            }
+
+            qreal pos = progress * Size;
+            int index = int(pos);
+            qreal frac = pos - index;
+            return samples[index] + (samples[index + 1] - samples[index]) * frac;
+        }
+
+    private:
+        std::array<float, Size + 1> samples;
+
+        static constexpr qreal bezier(qreal p1, qreal p2, qreal t) {
+            qreal u = 1 - t;
+            return 3 * u * u * t * p1 + 3 * u * t * t * p2 + t * t * t;
+        }
+
+        // x(t) is monotonic for control points inside [0, 1]
+        static constexpr qreal solve(qreal x1, qreal x2, qreal x) {
+            qreal lo = 0;
+            qreal hi = 1;
+            for (int i = 0; i < 30; ++i) {
+                qreal mid = (lo + hi) / 2;
+                if (bezier(x1, x2, mid) < x) {
+                    lo = mid;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+            return (lo + hi) / 2;
+        }
+    };
+
+
+    // Shared easing curve of a preset in motion::presets, backed by its table
+    QEasingCurve motionCurve(int preset);
+
+}
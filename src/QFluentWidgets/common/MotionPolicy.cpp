@@ -0,0 +1,105 @@
+#include "MotionPolicy.hpp"
+
+namespace fluent {
+
+    Q_GLOBAL_STATIC(MotionPolicy, globalMotionPolicy);
+
+
+    // Frames this many times slower than the display, for this many frames
+    // in a row, turn the automatic policy to the reduced frame rate
+    static const int SlowFrameFactor = 3;
+    static const int SlowFrameCount = 30;
+
+
+    MotionPolicy::MotionPolicy(QObject* parent)
+        : QObject(parent), m_mode(Mode::Full), m_reducedFrameRate(15), m_automatic(false),
+        averageInterval(0), slowFrames(0)
+    {
+        QByteArray env = qgetenv("QFLUENT_MOTION").toLower();
+        if (env == "reduced") {
+            m_mode = Mode::ReducedFrameRate;
+        }
+        else if (env == "instant") {
+            m_mode = Mode::Instant;
+        }
+        else if (env == "auto") {
+            m_automatic = true;
+        }
+        else if (!env.isEmpty() && env != "full") {
+            qWarning() << "Unknown QFLUENT_MOTION value:" << env;
+        }
+    }
+
+
+    void MotionPolicy::setMode(Mode mode) {
+        if (m_mode == mode) {
+            return;
+        }
+        m_mode = mode;
+        averageInterval = 0;
+        slowFrames = 0;
+        emit modeChanged(mode);
+    }
+
+
+    void MotionPolicy::setReducedFrameRate(int fps) {
+        m_reducedFrameRate = qBound(1, fps, 60);
+    }
+
+
+    int MotionPolicy::reducedFrameInterval() const {
+        return 1000 / m_reducedFrameRate;
+    }
+
+
+    void MotionPolicy::setAutomatic(bool automatic) {
+        m_automatic = automatic;
+        averageInterval = 0;
+        slowFrames = 0;
+    }
+
+
+    void MotionPolicy::reportFrameInterval(qint64 interval, int expected) {
+        if (!m_automatic || m_mode != Mode::Full || expected <= 0) {
+            return;
+        }
+
+        averageInterval = averageInterval > 0 ? 0.9 * averageInterval + 0.1 * interval : interval;
+        slowFrames = averageInterval > SlowFrameFactor * expected ? slowFrames + 1 : 0;
+
+        if (slowFrames >= SlowFrameCount) {
+            setMode(Mode::ReducedFrameRate);
+        }
+    }
+
+
+    MotionPolicy* motionPolicy() {
+        return globalMotionPolicy();
+    }
+
+
+    bool isInstantMotion(AnimationRole role) {
+        return motionPolicy()->isInstant() || animationQuality()->isInstant(role);
+    }
+
+
+    void applyMotionPolicy(
+        QVariantAnimation* ani,
+        AnimationRole role,
+        QAbstractAnimation::State newState,
+        QAbstractAnimation::State oldState,
+        int& savedDuration
+    ) {
+        if (newState == QAbstractAnimation::Running && oldState == QAbstractAnimation::Stopped) {
+            if (isInstantMotion(role) && ani->duration() > 0) {
+                savedDuration = ani->duration();
+                ani->setDuration(0);
+            }
+        }
+        else if (newState == QAbstractAnimation::Stopped && savedDuration >= 0) {
+            ani->setDuration(savedDuration);
+            savedDuration = -1;
+        }
+    }
+
+}
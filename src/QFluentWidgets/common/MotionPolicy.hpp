@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QObject>
+#include <QVariantAnimation>
+
+#include "QFluentWidgets/common/AnimationQuality.hpp"
+
+namespace fluent {
+
+    // Global motion policy honored by every Fluent animation. Set it at
+    // runtime or through QFLUENT_MOTION=full|reduced|instant|auto, where auto
+    // starts at full and drops to the reduced frame rate when frames degrade.
+    class MotionPolicy : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        enum class Mode {
+            Full,
+            ReducedFrameRate,
+            Instant
+        };
+        Q_ENUM(Mode)
+
+        explicit MotionPolicy(QObject* parent = nullptr);
+
+        Mode mode() const { return m_mode; }
+        void setMode(Mode mode);
+
+        bool isInstant() const { return m_mode == Mode::Instant; }
+
+        int reducedFrameRate() const { return m_reducedFrameRate; }
+        void setReducedFrameRate(int fps);
+        int reducedFrameInterval() const;
+
+        bool isAutomatic() const { return m_automatic; }
+        void setAutomatic(bool automatic);
+
+        // Fed by the animation driver with the time between two ticks of a
+        // running animation while in full mode
+        void reportFrameInterval(qint64 interval, int expected);
+
+    signals:
+        void modeChanged(Mode mode);
+
+    private:
+        Mode m_mode;
+        int m_reducedFrameRate;
+        bool m_automatic;
+        qreal averageInterval;
+        int slowFrames;
+    };
+
+
+    MotionPolicy* motionPolicy();
+
+
+    // Instant mode, or a role the quality scheduler made instant
+    bool isInstantMotion(AnimationRole role);
+
+
+    // For updateState() of QVariantAnimation subclasses: runs the animation
+    // with a zero duration while its motion is instant and restores it once stopped
+    void applyMotionPolicy(QVariantAnimation* ani, AnimationRole role, QAbstractAnimation::State newState,
+        QAbstractAnimation::State oldState, int& savedDuration);
+
+}
@@ -0,0 +1,202 @@
+#include "Shadow.hpp"
+
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+#include "QFluentWidgets/common/EventDispatcher.hpp"
+
+#include <QPixmapCache>
+#include <QImage>
+#include <QPainterPath>
+#include <qdrawutil.h>
+#include <QtMath>
+
+#include <opencv2/imgproc.hpp>
+
+namespace fluent {
+
+    // The stretched middle slices must be far enough from every edge of the
+    // blurred rect not to see them, so the core is at least as large as the blur
+    static int patchBorder(const ShadowStyle& style) {
+        return style.blurRadius + qMax(style.cornerRadius, style.blurRadius);
+    }
+
+
+    // The blurred rounded rect of size core, padded by the blur radius
+    static QPixmap renderShadow(const ShadowStyle& style, const QSize& core, qreal devicePixelRatio) {
+        QSize size = (core + QSize(2 * style.blurRadius, 2 * style.blurRadius)) * devicePixelRatio;
+
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        {
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.scale(devicePixelRatio, devicePixelRatio);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(style.color);
+
+            QRectF rect(QPointF(style.blurRadius, style.blurRadius), QSizeF(core));
+            painter.drawRoundedRect(rect, style.cornerRadius, style.cornerRadius);
+        }
+
+        // Premultiplied channels blur correctly as they are
+        if (style.blurRadius > 0) {
+            cv::Mat mat(image.height(), image.width(), CV_8UC4, image.bits(), image.bytesPerLine());
+            cv::GaussianBlur(mat, mat, cv::Size(0, 0), style.blurRadius * devicePixelRatio / 3.0);
+        }
+
+        QPixmap pixmap = QPixmap::fromImage(image);
+        pixmap.setDevicePixelRatio(devicePixelRatio);
+        return pixmap;
+    }
+
+
+    static QString shadowKey(const ShadowStyle& style, const QSize& core, qreal devicePixelRatio) {
+        return QString("fluent_shadow_%1_%2_%3_%4_%5x%6")
+            .arg(style.blurRadius)
+            .arg(style.cornerRadius)
+            .arg(style.color.rgba(), 8, 16, QChar('0'))
+            .arg(devicePixelRatio)
+            .arg(core.width())
+            .arg(core.height());
+    }
+
+
+    QPixmap ShadowRenderer::ninePatch(const ShadowStyle& style, qreal devicePixelRatio) {
+        int border = patchBorder(style);
+        int side = 2 * border + 1;
+        QSize core(side - 2 * style.blurRadius, side - 2 * style.blurRadius);
+        QString key = shadowKey(style, core, devicePixelRatio);
+
+        QPixmap pixmap;
+        if (!QPixmapCache::find(key, &pixmap)) {
+            pixmap = renderShadow(style, core, devicePixelRatio);
+            QPixmapCache::insert(key, pixmap);
+        }
+        return pixmap;
+    }
+
+
+    QMargins ShadowRenderer::margins(const ShadowStyle& style) {
+        QPoint offset = style.offset;
+        return QMargins(
+            style.blurRadius + qMax(0, -offset.x()),
+            style.blurRadius + qMax(0, -offset.y()),
+            style.blurRadius + qMax(0, offset.x()),
+            style.blurRadius + qMax(0, offset.y())
+        );
+    }
+
+
+    void ShadowRenderer::paint(QPainter* painter, const QRect& rect, const ShadowStyle& style, qreal opacity) {
+        if (opacity <= 0 || style.color.alpha() == 0 || rect.isEmpty()) {
+            return;
+        }
+
+        qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : 1;
+        int border = patchBorder(style);
+        QRect target = rect.translated(style.offset).adjusted(-style.blurRadius, -style.blurRadius, style.blurRadius, style.blurRadius);
+
+        painter->save();
+        painter->setOpacity(painter->opacity() * opacity);
+
+        // The nine-patch margins would overlap on a target smaller than both
+        // borders and draw the corners twice, small rects get their own shadow
+        if (target.width() < 2 * border || target.height() < 2 * border) {
+            QString key = shadowKey(style, rect.size(), dpr);
+            QPixmap pixmap;
+            if (!QPixmapCache::find(key, &pixmap)) {
+                pixmap = renderShadow(style, rect.size(), dpr);
+                QPixmapCache::insert(key, pixmap);
+            }
+            painter->drawPixmap(target.topLeft(), pixmap);
+        }
+        else {
+            qDrawBorderPixmap(painter, target, QMargins(border, border, border, border), ninePatch(style, dpr));
+        }
+        painter->restore();
+    }
+
+
+
+    ShadowWidget::ShadowWidget(QWidget* target)
+        : QWidget(target->parentWidget()), target(target), m_opacity(0)
+    {
+        setAttribute(Qt::WA_TransparentForMouseEvents);
+        setAttribute(Qt::WA_NoSystemBackground);
+        setFocusPolicy(Qt::NoFocus);
+
+        WidgetEventDispatcher::of(target)->subscribe(this,
+            { QEvent::Move, QEvent::Resize, QEvent::Show, QEvent::Hide, QEvent::ZOrderChange },
+            [this](QWidget* w, QEvent* e) { return eventFilter(w, e); });
+        syncGeometry();
+        stackUnder(target);
+        setVisible(target->isVisible());
+    }
+
+
+    qreal ShadowWidget::opacity() const {
+        return m_opacity;
+    }
+
+
+    void ShadowWidget::setOpacity(qreal opacity) {
+        m_opacity = opacity;
+        animationDriver()->scheduleUpdate(this);
+    }
+
+
+    ShadowStyle ShadowWidget::style() const {
+        return m_style;
+    }
+
+
+    void ShadowWidget::setStyle(const ShadowStyle& style) {
+        m_style = style;
+        syncGeometry();
+        update();
+    }
+
+
+    void ShadowWidget::paintEvent(QPaintEvent* e) {
+        if (!target) {
+            return;
+        }
+
+        QPainter painter(this);
+        QRect rect(target->geometry().topLeft() - pos(), target->size());
+        ShadowRenderer::paint(&painter, rect, m_style, m_opacity);
+    }
+
+
+    bool ShadowWidget::eventFilter(QObject* obj, QEvent* e) {
+        if (obj == target) {
+            switch (e->type()) {
+            case QEvent::Move:
+            case QEvent::Resize:
+                syncGeometry();
+                break;
+            case QEvent::Show:
+                syncGeometry();
+                stackUnder(target);
+                show();
+                break;
+            case QEvent::Hide:
+                hide();
+                break;
+            case QEvent::ZOrderChange:
+                stackUnder(target);
+                break;
+            default:
+                break;
+            }
+        }
+        return QWidget::eventFilter(obj, e);
+    }
+
+
+    void ShadowWidget::syncGeometry() {
+        if (target) {
+            setGeometry(target->geometry().marginsAdded(ShadowRenderer::margins(m_style)));
+        }
+    }
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QWidget>
+#include <QPainter>
+#include <QPixmap>
+#include <QColor>
+#include <QPoint>
+#include <QPointer>
+#include <QMargins>
+#include <QEvent>
+
+namespace fluent {
+
+    struct ShadowStyle {
+        int blurRadius = 38;
+        QPoint offset;
+        int cornerRadius = 0;
+        QColor color = QColor(0, 0, 0, 75);
+    };
+
+
+    // Blurred rounded-rect shadows drawn as a nine-patch. The blur is computed
+    // once per blur radius, corner radius, color and device pixel ratio and
+    // kept in QPixmapCache, painting only stretches the cached pixmap.
+    class ShadowRenderer {
+    public:
+        static QPixmap ninePatch(const ShadowStyle& style, qreal devicePixelRatio);
+
+        // Space the shadow needs around the casting rect
+        static QMargins margins(const ShadowStyle& style);
+
+        // Draws the shadow of rect, the offset of the style is applied here
+        static void paint(QPainter* painter, const QRect& rect, const ShadowStyle& style, qreal opacity = 1);
+    };
+
+
+    // Paints the shadow of a widget from underneath it. It is a sibling
+    // stacked below the target, so the target itself renders directly.
+    class ShadowWidget : public QWidget
+    {
+        Q_OBJECT
+        Q_PROPERTY(qreal opacity READ opacity WRITE setOpacity)
+
+    public:
+        explicit ShadowWidget(QWidget* target);
+
+        qreal opacity() const;
+        void setOpacity(qreal opacity);
+
+        ShadowStyle style() const;
+        void setStyle(const ShadowStyle& style);
+
+    protected:
+        void paintEvent(QPaintEvent* e) override;
+        bool eventFilter(QObject* obj, QEvent* e) override;
+
+    private:
+        QPointer<QWidget> target;
+        ShadowStyle m_style;
+        qreal m_opacity;
+
+        void syncGeometry();
+    };
+
+}
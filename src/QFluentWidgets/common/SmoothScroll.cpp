@@ -1,5 +1,8 @@
 #include "SmoothScroll.hpp"
 
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+#include "QFluentWidgets/common/MotionPolicy.hpp"
+
 namespace fluent {
 
 
@@ -8,10 +11,10 @@ namespace fluent {
         Qt::Orientation orient,
         QObject* parent
     ) : QObject(parent), widget(widget), orient(orient), fps(60), duration(400),
-        stepsTotal(0), stepRatio(1.5), acceleration(1), lastWheelEvent(nullptr), smoothMode(SmoothMode::LINEAR)
+        stepsTotal(0), stepRatio(1.5), acceleration(1), stepsDone(0), smoothMode(SmoothMode::LINEAR)
     {
-        smoothMoveTimer = new QTimer(widget);
-        connect(smoothMoveTimer, &QTimer::timeout, this, &SmoothScroll::smoothMove);
+        // Steps are paced by the animation driver, so they follow its clock
+        ticker = new AnimationTicker([this](int currentTime) { onTick(currentTime); }, this);
     }
 
 
@@ -22,19 +25,19 @@ namespace fluent {
 
     void SmoothScroll::wheelEvent(QWheelEvent* e) {
         int delta = e->angleDelta().y() != 0 ? e->angleDelta().y() : e->angleDelta().x();
-        if (smoothMode == SmoothMode::NO_SMOOTH || std::abs(delta) % 120 != 0) {
+        if (smoothMode == SmoothMode::NO_SMOOTH || motionPolicy()->isInstant() || std::abs(delta) % 120 != 0) {
             ((MyScrollArea*)widget)->wheelEvent(e);
             return;
         }
 
-        qint64 now = QDateTime::currentMSecsSinceEpoch();
+        qint64 now = animationDriver()->now();
         scrollStamps.enqueue(now);
         while (now - scrollStamps.head() > 500) {
             scrollStamps.dequeue();
         }
 
         double accelerationRatio = std::min(scrollStamps.size() / 15.0, 1.0);
-        lastWheelEvent = e;
+        lastWheelEvent.reset(e->clone());
 
         stepsTotal = fps * duration / 1000;
         delta *= stepRatio;
@@ -43,7 +46,20 @@ namespace fluent {
         }
 
         stepsLeftQueue.enqueue(QPair<int, int>(delta, stepsTotal));
-        smoothMoveTimer->start(1000 / fps);
+        if (ticker->state() != QAbstractAnimation::Running) {
+            stepsDone = 0;
+            ticker->start();
+        }
+    }
+
+
+    void SmoothScroll::onTick(int currentTime) {
+        // One step per 1000 / fps ms, catching up if a frame took longer
+        int due = currentTime * fps / 1000;
+        while (stepsDone < due && !stepsLeftQueue.isEmpty()) {
+            ++stepsDone;
+            smoothMove();
+        }
     }
 
 
@@ -112,7 +128,7 @@ namespace fluent {
         QApplication::sendEvent(bar, &e);
 
         if (stepsLeftQueue.isEmpty()) {
-            smoothMoveTimer->stop();
+            ticker->stop();
         }
     }
 
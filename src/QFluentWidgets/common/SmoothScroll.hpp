@@ -4,16 +4,18 @@
 #include <QScrollArea>
 #include <QAbstractScrollArea>
 #include <QWheelEvent>
-#include <QTimer>
-#include <QDateTime>
 #include <QPoint>
 #include <QQueue>
 #include <QScrollBar>
 #include <cmath>
+#include <memory>
 
 
 namespace fluent {
 
+    class AnimationTicker;
+
+
     enum class SmoothMode {
         NO_SMOOTH = 0,
         CONSTANT,
@@ -40,10 +42,10 @@ namespace fluent {
         void setSmoothMode(SmoothMode mode);
         void wheelEvent(QWheelEvent* e);
 
-    private slots:
+    private:
+        void onTick(int currentTime);
         void smoothMove();
 
-    private:
         int subDelta(int delta, int stepsLeft);
 
         QScrollArea* widget;
@@ -53,10 +55,11 @@ namespace fluent {
         int stepsTotal;
         double stepRatio;
         int acceleration;
-        QWheelEvent* lastWheelEvent;
+        std::unique_ptr<QWheelEvent> lastWheelEvent;
         QQueue<qint64> scrollStamps;
         QQueue<QPair<int, int>> stepsLeftQueue;
-        QTimer* smoothMoveTimer;
+        AnimationTicker* ticker;
+        int stepsDone;
         SmoothMode smoothMode;
     };
 }
\ No newline at end of file
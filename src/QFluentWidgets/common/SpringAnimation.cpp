@@ -0,0 +1,113 @@
+#include "SpringAnimation.hpp"
+
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+#include "QFluentWidgets/common/MotionPolicy.hpp"
+#include "QFluentWidgets/common/AnimationProfiler.hpp"
+
+namespace fluent {
+
+    // Fixed integration step, frames are split into steps of at most this
+    // long and a stalled frame is capped so the spring cannot blow up
+    static const int MaxStepMs = 4;
+    static const int MaxFrameMs = 100;
+
+
+    SpringAnimationBase::SpringAnimationBase(QObject* parent)
+        : QAbstractAnimation(parent), m_stiffness(400), m_dampingRatio(1), m_mass(1), m_restDistance(0.001),
+        m_restSpeed(0.01), lastTime(0), lastApplied(0), m_role(AnimationRole::Decorative)
+    {
+        animationDriver();
+    }
+
+
+    void SpringAnimationBase::setStiffness(qreal stiffness) {
+        m_stiffness = qMax<qreal>(1, stiffness);
+    }
+
+
+    void SpringAnimationBase::setDampingRatio(qreal ratio) {
+        m_dampingRatio = qMax<qreal>(0, ratio);
+    }
+
+
+    void SpringAnimationBase::setMass(qreal mass) {
+        m_mass = qMax<qreal>(0.01, mass);
+    }
+
+
+    void SpringAnimationBase::setRestThreshold(qreal distance, qreal speed) {
+        m_restDistance = qMax<qreal>(0, distance);
+        m_restSpeed = qMax<qreal>(0, speed);
+    }
+
+
+    void SpringAnimationBase::setUpdateWidget(QWidget* widget) {
+        updateWidget = widget;
+    }
+
+
+    qreal SpringAnimationBase::damping() const {
+        return 2 * m_dampingRatio * qSqrt(m_stiffness * m_mass);
+    }
+
+
+    void SpringAnimationBase::ensureRunning() {
+        if (isInstantMotion(m_role)) {
+            stop();
+            snapToTarget();
+            write();
+            if (updateWidget) {
+                animationDriver()->scheduleUpdate(updateWidget);
+            }
+            return;
+        }
+
+        if (state() != QAbstractAnimation::Running) {
+            start();
+        }
+    }
+
+
+    void SpringAnimationBase::updateCurrentTime(int currentTime) {
+        // A skipped tick is integrated with the next one
+        if (animationQuality()->skipTick(m_role, currentTime, lastApplied, -1)) {
+            return;
+        }
+
+        int elapsed = qMin(currentTime - lastTime, MaxFrameMs);
+        lastTime = currentTime;
+        if (elapsed <= 0) {
+            return;
+        }
+
+        bool settled = false;
+        if (isInstantMotion(m_role)) {
+            snapToTarget();
+            settled = true;
+        }
+
+        for (int left = elapsed; left > 0 && !settled; left -= MaxStepMs) {
+            settled = step(qMin(left, MaxStepMs) / 1000.0);
+        }
+
+        write();
+        if (updateWidget) {
+            animationDriver()->scheduleUpdate(updateWidget);
+        }
+        animationProfiler()->ticked(this);
+
+        if (settled) {
+            stop();
+        }
+    }
+
+
+    void SpringAnimationBase::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) {
+        if (newState == QAbstractAnimation::Running && oldState == QAbstractAnimation::Stopped) {
+            lastTime = 0;
+        }
+        animationProfiler()->stateChanged(this, updateWidget ? updateWidget.data() : parent(), newState);
+        QAbstractAnimation::updateState(newState, oldState);
+    }
+
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <QAbstractAnimation>
+#include <QPointer>
+#include <QWidget>
+#include <QColor>
+#include <QPoint>
+#include <QPointF>
+#include <QSize>
+#include <QSizeF>
+#include <QtMath>
+#include <array>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "QFluentWidgets/common/Animations.hpp"
+
+namespace fluent {
+
+    // Component view of the spring-animated types. RestDistance is the distance
+    // to the target under which a component counts as settled, RestSpeed the
+    // speed per second, ten distances: slower than that a component moves
+    // less than a fifth of a distance per frame.
+    template <typename T, typename = void>
+    struct SpringTraits;
+
+
+    template <typename T>
+    struct SpringTraits<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+        static constexpr int Size = 1;
+        static constexpr qreal RestDistance = std::is_integral_v<T> ? 0.5 : 0.001;
+        static constexpr qreal RestSpeed = 10 * RestDistance;
+
+        static std::array<qreal, Size> toArray(const T& value) { return { qreal(value) }; }
+        static T fromArray(const std::array<qreal, Size>& v) {
+            if constexpr (std::is_integral_v<T>) {
+                return T(qRound(v[0]));
+            }
+            else {
+                return T(v[0]);
+            }
+        }
+    };
+
+
+    template <>
+    struct SpringTraits<QPointF> {
+        static constexpr int Size = 2;
+        static constexpr qreal RestDistance = 0.1;
+        static constexpr qreal RestSpeed = 10 * RestDistance;
+
+        static std::array<qreal, Size> toArray(const QPointF& p) { return { p.x(), p.y() }; }
+        static QPointF fromArray(const std::array<qreal, Size>& v) { return QPointF(v[0], v[1]); }
+    };
+
+
+    template <>
+    struct SpringTraits<QPoint> {
+        static constexpr int Size = 2;
+        static constexpr qreal RestDistance = 0.5;
+        static constexpr qreal RestSpeed = 10 * RestDistance;
+
+        static std::array<qreal, Size> toArray(const QPoint& p) { return { qreal(p.x()), qreal(p.y()) }; }
+        static QPoint fromArray(const std::array<qreal, Size>& v) { return QPoint(qRound(v[0]), qRound(v[1])); }
+    };
+
+
+    template <>
+    struct SpringTraits<QSizeF> {
+        static constexpr int Size = 2;
+        static constexpr qreal RestDistance = 0.1;
+        static constexpr qreal RestSpeed = 10 * RestDistance;
+
+        static std::array<qreal, Size> toArray(const QSizeF& s) { return { s.width(), s.height() }; }
+        static QSizeF fromArray(const std::array<qreal, Size>& v) { return QSizeF(v[0], v[1]); }
+    };
+
+
+    template <>
+    struct SpringTraits<QSize> {
+        static constexpr int Size = 2;
+        static constexpr qreal RestDistance = 0.5;
+        static constexpr qreal RestSpeed = 10 * RestDistance;
+
+        static std::array<qreal, Size> toArray(const QSize& s) { return { qreal(s.width()), qreal(s.height()) }; }
+        static QSize fromArray(const std::array<qreal, Size>& v) { return QSize(qRound(v[0]), qRound(v[1])); }
+    };
+
+
+    template <>
+    struct SpringTraits<QColor> {
+        static constexpr int Size = 4;
+        static constexpr qreal RestDistance = 0.5;
+        static constexpr qreal RestSpeed = 10 * RestDistance;
+
+        static std::array<qreal, Size> toArray(const QColor& c) {
+            QRgb rgba = c.rgba();
+            return { qreal(qRed(rgba)), qreal(qGreen(rgba)), qreal(qBlue(rgba)), qreal(qAlpha(rgba)) };
+        }
+
+        static QColor fromArray(const std::array<qreal, Size>& v) {
+            auto channel = [](qreal c) { return qBound(0, qRound(c), 255); };
+            return QColor(channel(v[0]), channel(v[1]), channel(v[2]), channel(v[3]));
+        }
+    };
+
+
+    // Non-template part: spring parameters and time stepping. The animation
+    // runs until the value settles on the target; retargeting keeps it
+    // running with its current velocity instead of restarting.
+    class SpringAnimationBase : public QAbstractAnimation
+    {
+        Q_OBJECT
+
+    public:
+        explicit SpringAnimationBase(QObject* parent = nullptr);
+
+        int duration() const override { return -1; }
+
+        qreal stiffness() const { return m_stiffness; }
+        void setStiffness(qreal stiffness);
+
+        // 1 is critically damped, lower values overshoot and bounce
+        qreal dampingRatio() const { return m_dampingRatio; }
+        void setDampingRatio(qreal ratio);
+
+        qreal mass() const { return m_mass; }
+        void setMass(qreal mass);
+
+        // Settle thresholds, by default those of the SpringTraits of the type.
+        // A float spring holding pixels should rest at a fraction of a pixel.
+        qreal restDistance() const { return m_restDistance; }
+        qreal restSpeed() const { return m_restSpeed; }
+        void setRestThreshold(qreal distance, qreal speed);
+
+        // Widget repainted through the animation driver after each write
+        void setUpdateWidget(QWidget* widget);
+
+        AnimationRole role() const { return m_role; }
+        void setRole(AnimationRole role) { m_role = role; }
+
+    protected:
+        void updateCurrentTime(int currentTime) override;
+        void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) override;
+
+        // Integrates dt seconds, returns true once settled
+        virtual bool step(qreal dt) = 0;
+        virtual void snapToTarget() = 0;
+        virtual void write() = 0;
+
+        qreal damping() const;
+        void ensureRunning();
+
+    private:
+        qreal m_stiffness;
+        qreal m_dampingRatio;
+        qreal m_mass;
+        qreal m_restDistance;
+        qreal m_restSpeed;
+        int lastTime;
+        int lastApplied;
+        AnimationRole m_role;
+        QPointer<QWidget> updateWidget;
+    };
+
+
+    template <typename T>
+    class SpringAnimation : public SpringAnimationBase
+    {
+        using Traits = SpringTraits<T>;
+        using Vector = std::array<qreal, Traits::Size>;
+
+    public:
+        using Setter = std::function<void(const T&)>;
+
+        explicit SpringAnimation(Setter setter, QObject* parent = nullptr)
+            : SpringAnimationBase(parent), setter(std::move(setter)), position{}, velocity{}, m_target{}
+        {
+            setRestThreshold(Traits::RestDistance, Traits::RestSpeed);
+        }
+
+        template <typename Obj, typename Arg>
+        SpringAnimation(Obj* obj, void (Obj::*method)(Arg), QObject* parent = nullptr)
+            : SpringAnimation([obj, method](const T& value) { (obj->*method)(value); }, parent)
+        {}
+
+        template <typename Obj>
+        SpringAnimation(Obj* obj, T Obj::*member, QObject* parent = nullptr)
+            : SpringAnimation([obj, member](const T& value) { obj->*member = value; }, parent)
+        {}
+
+        T value() const { return Traits::fromArray(position); }
+        T target() const { return Traits::fromArray(m_target); }
+
+        // Jumps to value and rests there
+        void setValue(const T& value) {
+            stop();
+            position = m_target = Traits::toArray(value);
+            velocity = Vector{};
+            write();
+        }
+
+        // Retargets the spring, mid-flight it keeps its position and velocity
+        void setTarget(const T& target) {
+            m_target = Traits::toArray(target);
+            ensureRunning();
+        }
+
+    protected:
+        bool step(qreal dt) override {
+            qreal k = stiffness();
+            qreal c = damping();
+            qreal m = mass();
+
+            bool settled = true;
+            for (int i = 0; i < Traits::Size; ++i) {
+                qreal force = -k * (position[i] - m_target[i]) - c * velocity[i];
+                velocity[i] += force / m * dt;
+                position[i] += velocity[i] * dt;
+
+                settled = settled && qAbs(position[i] - m_target[i]) < restDistance()
+                    && qAbs(velocity[i]) < restSpeed();
+            }
+
+            if (settled) {
+                position = m_target;
+                velocity = Vector{};
+            }
+            return settled;
+        }
+
+        void write() override {
+            setter(Traits::fromArray(position));
+        }
+
+        void snapToTarget() override {
+            position = m_target;
+            velocity = Vector{};
+        }
+
+    private:
+        Setter setter;
+        Vector position;
+        Vector velocity;
+        Vector m_target;
+    };
+
+
+    template <typename T, typename Setter>
+    SpringAnimation<T>* FluentAnimation::createSpring(Setter setter, QObject* parent) {
+        return new SpringAnimation<T>(typename SpringAnimation<T>::Setter(std::move(setter)), parent);
+    }
+
+}
@@ -0,0 +1,141 @@
+#include "StaggerAnimation.hpp"
+
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+#include "QFluentWidgets/common/MotionPolicy.hpp"
+#include "QFluentWidgets/common/AnimationProfiler.hpp"
+
+namespace fluent {
+
+    StaggerAnimationBase::StaggerAnimationBase(QObject* parent)
+        : QAbstractAnimation(parent), m_itemDuration(250), m_stagger(30), maxDelay(0),
+        orderedDelays(true), firstActive(0), lastApplied(0), m_role(AnimationRole::Decorative)
+    {
+        animationDriver();
+    }
+
+
+    int StaggerAnimationBase::duration() const {
+        if (isInstantMotion(m_role) || itemCount() == 0) {
+            return 0;
+        }
+        return maxDelay + m_itemDuration;
+    }
+
+
+    void StaggerAnimationBase::setItemDuration(int msecs) {
+        m_itemDuration = qMax(0, msecs);
+    }
+
+
+    void StaggerAnimationBase::setStagger(int msecs) {
+        m_stagger = qMax(0, msecs);
+        rescanDelays();
+    }
+
+
+    void StaggerAnimationBase::setEasingCurve(const QEasingCurve& curve) {
+        m_easingCurve = curve;
+    }
+
+
+    void StaggerAnimationBase::setMotion(FluentAnimationType aniType, FluentAnimationSpeed speed) {
+        const MotionPreset& preset = motion::presets[static_cast<int>(aniType)];
+        setItemDuration(preset.durations[static_cast<int>(speed)]);
+        setEasingCurve(FluentAnimation::curve(aniType));
+    }
+
+
+    void StaggerAnimationBase::setUpdateWidget(QWidget* widget) {
+        updateWidget = widget;
+    }
+
+
+    void StaggerAnimationBase::itemAdded(bool ordered) {
+        int count = itemCount();
+        orderedDelays = (count == 1 || orderedDelays) && ordered;
+        maxDelay = count == 1 ? itemDelay(0) : qMax(maxDelay, itemDelay(count - 1));
+    }
+
+
+    void StaggerAnimationBase::rescanDelays() {
+        orderedDelays = true;
+        maxDelay = 0;
+
+        int previous = 0;
+        for (int i = 0; i < itemCount(); ++i) {
+            int delay = itemDelay(i);
+            orderedDelays = orderedDelays && delay >= previous;
+            maxDelay = qMax(maxDelay, delay);
+            previous = delay;
+        }
+    }
+
+
+    void StaggerAnimationBase::updateCurrentTime(int currentTime) {
+        if (animationQuality()->skipTick(m_role, currentTime, lastApplied, duration())) {
+            return;
+        }
+
+        int count = itemCount();
+        bool instant = duration() == 0;
+        if (int(itemStates.size()) != count) {
+            itemStates.assign(count, Unknown);
+        }
+
+        // With ordered delays the finished items form a prefix and the pending
+        // ones a suffix, so a tick only visits the items currently in flight.
+        // Otherwise every item is visited, but pending and finished ones are
+        // only written when they change state.
+        bool changed = false;
+        for (int i = orderedDelays ? firstActive : 0; i < count; ++i) {
+            int local = currentTime - itemDelay(i);
+            if (local < 0 && !instant) {
+                if (orderedDelays) {
+                    break;
+                }
+                if (itemStates[i] != Pending) {
+                    itemStates[i] = Pending;
+                    applyItem(i, m_easingCurve.valueForProgress(0));
+                    changed = true;
+                }
+                continue;
+            }
+
+            qreal progress = instant || m_itemDuration == 0 ? 1 : qMin<qreal>(1, qreal(local) / m_itemDuration);
+            if (progress < 1 || itemStates[i] != Finished) {
+                itemStates[i] = progress < 1 ? Running : Finished;
+                applyItem(i, m_easingCurve.valueForProgress(progress));
+                changed = true;
+            }
+
+            if (progress >= 1 && orderedDelays && i == firstActive) {
+                ++firstActive;
+            }
+        }
+
+        if (changed && updateWidget) {
+            animationDriver()->scheduleUpdate(updateWidget);
+        }
+        animationProfiler()->ticked(this);
+    }
+
+
+    void StaggerAnimationBase::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) {
+        if (newState == QAbstractAnimation::Running && oldState == QAbstractAnimation::Stopped) {
+            firstActive = 0;
+            itemStates.assign(itemCount(), Unknown);
+
+            // Items still waiting for their delay show their start value
+            if (duration() > 0) {
+                qreal start = m_easingCurve.valueForProgress(0);
+                for (int i = 0; i < itemCount(); ++i) {
+                    itemStates[i] = Pending;
+                    applyItem(i, start);
+                }
+            }
+        }
+        animationProfiler()->stateChanged(this, updateWidget ? updateWidget.data() : parent(), newState);
+        QAbstractAnimation::updateState(newState, oldState);
+    }
+
+}
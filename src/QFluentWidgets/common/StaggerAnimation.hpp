@@ -0,0 +1,135 @@
+#pragma once
+
+#include <QAbstractAnimation>
+#include <QEasingCurve>
+#include <QPointer>
+#include <QWidget>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "QFluentWidgets/common/TypedAnimation.hpp"
+
+namespace fluent {
+
+    // Non-template part: timing of the items. Item i starts after its delay
+    // (i * stagger unless given) and runs for itemDuration, the whole group is
+    // one animation advanced by one driver tick.
+    class StaggerAnimationBase : public QAbstractAnimation
+    {
+        Q_OBJECT
+
+    public:
+        explicit StaggerAnimationBase(QObject* parent = nullptr);
+
+        int duration() const override;
+
+        int itemDuration() const { return m_itemDuration; }
+        void setItemDuration(int msecs);
+
+        int stagger() const { return m_stagger; }
+        void setStagger(int msecs);
+
+        QEasingCurve easingCurve() const { return m_easingCurve; }
+        void setEasingCurve(const QEasingCurve& curve);
+
+        // Item duration and curve of a Fluent motion preset
+        void setMotion(FluentAnimationType aniType, FluentAnimationSpeed speed = FluentAnimationSpeed::FAST);
+
+        // Widget repainted once per tick, e.g. the viewport holding the items
+        void setUpdateWidget(QWidget* widget);
+
+        AnimationRole role() const { return m_role; }
+        void setRole(AnimationRole role) { m_role = role; }
+
+    protected:
+        void updateCurrentTime(int currentTime) override;
+        void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) override;
+
+        virtual int itemCount() const = 0;
+        virtual int itemDelay(int index) const = 0;
+        virtual void applyItem(int index, qreal progress) = 0;
+
+        int defaultDelay(int index) const { return index * m_stagger; }
+        void itemAdded(bool ordered);
+        void rescanDelays();
+
+    private:
+        // Last value written to each item, so unchanged items are skipped
+        enum ItemState : quint8 { Unknown, Pending, Running, Finished };
+
+        int m_itemDuration;
+        int m_stagger;
+        int maxDelay;
+        bool orderedDelays;
+        int firstActive;
+        int lastApplied;
+        AnimationRole m_role;
+        QEasingCurve m_easingCurve;
+        QPointer<QWidget> updateWidget;
+        std::vector<ItemState> itemStates;
+    };
+
+
+    // Staggered animation of N values of type T with one callback and the
+    // items stored contiguously, thousands of rows cost one vector
+    template <typename T>
+    class StaggerAnimation : public StaggerAnimationBase
+    {
+    public:
+        using Callback = std::function<void(int index, const T& value)>;
+
+        explicit StaggerAnimation(Callback callback, QObject* parent = nullptr)
+            : StaggerAnimationBase(parent), callback(std::move(callback))
+        {}
+
+        void reserve(int count) {
+            items.reserve(count);
+        }
+
+        // A negative delay uses index * stagger. Call while stopped.
+        int addItem(const T& from, const T& to, int delay = -1) {
+            int index = int(items.size());
+            items.push_back({ from, to, delay });
+            itemAdded(isOrderedAfter(index));
+            return index;
+        }
+
+        void clear() {
+            items.clear();
+            rescanDelays();
+        }
+
+        int count() const { return int(items.size()); }
+
+    protected:
+        int itemCount() const override {
+            return int(items.size());
+        }
+
+        int itemDelay(int index) const override {
+            int delay = items[index].delay;
+            return delay < 0 ? defaultDelay(index) : delay;
+        }
+
+        void applyItem(int index, qreal progress) override {
+            const Item& item = items[index];
+            callback(index, AnimationTraits<T>::lerp(item.from, item.to, progress));
+        }
+
+    private:
+        struct Item {
+            T from;
+            T to;
+            int delay;
+        };
+
+        Callback callback;
+        std::vector<Item> items;
+
+        bool isOrderedAfter(int index) const {
+            return index == 0 || itemDelay(index) >= itemDelay(index - 1);
+        }
+    };
+
+}
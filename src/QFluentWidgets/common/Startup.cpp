@@ -0,0 +1,202 @@
+#include "Startup.hpp"
+
+#include "QFluentWidgets/common/Config.hpp"
+#include "QFluentWidgets/common/Font.hpp"
+#include "QFluentWidgets/common/Icons.hpp"
+#include "QFluentWidgets/common/StyleSheet.hpp"
+#include "QFluentWidgets/common/ThemeState.hpp"
+#include "QFluentWidgets/common/ThemeSnapshot.hpp"
+
+#include <QThread>
+#include <QDeadlineTimer>
+#include <QMutexLocker>
+#include <QDebug>
+
+namespace fluent {
+
+    StartupPipeline::StartupPipeline(QObject* parent)
+        : QObject(parent), started(false)
+    {
+        for (Stage stage : { Stage::Theme, Stage::Font, Stage::StyleSheet, Stage::Icon }) {
+            StageTiming timing;
+            timing.stage = stage;
+            timing.name = stageName(stage);
+            stages.append(timing);
+        }
+    }
+
+
+    StartupPipeline::~StartupPipeline() {
+        pool.waitForDone();
+    }
+
+
+    void StartupPipeline::start() {
+        if (started) {
+            return;
+        }
+        started = true;
+        clock.start();
+
+        // QObjects must be created on the GUI thread, so the theme stays here
+        runStage(Stage::Theme, true, [] {
+            themeState();
+            qconfigInstance();
+            ThemeSnapshot::publish();
+            return true;
+        });
+
+        // Warm the variants the styling code will ask for: the configured mode,
+        // with Auto resolved against the platform like FluentStyleSheet::path
+        Theme::Mode theme = qconfig->themeMode->value().value<Theme::Mode>();
+        if (theme == Theme::Mode::Auto) {
+            theme = ThemeSnapshot::current()->isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light;
+        }
+
+        runStageAsync(Stage::Font, true, [] {
+            return Font::loadMSFont();
+        });
+
+        runStageAsync(Stage::StyleSheet, false, [theme] {
+            preloadStyleSheets(theme);
+            return true;
+        });
+
+        runStageAsync(Stage::Icon, false, [theme] {
+            preloadIcons(theme);
+            return true;
+        });
+    }
+
+
+    bool StartupPipeline::waitForCritical(int timeout) {
+        return waitFor(true, timeout);
+    }
+
+
+    bool StartupPipeline::waitForFinished(int timeout) {
+        return waitFor(false, timeout);
+    }
+
+
+    bool StartupPipeline::isFinished() const {
+        QMutexLocker locker(&mutex);
+        for (const auto& timing : stages) {
+            if (!timing.finished) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    QList<StartupPipeline::StageTiming> StartupPipeline::timeline() const {
+        QMutexLocker locker(&mutex);
+        return stages;
+    }
+
+
+    QString StartupPipeline::report() const {
+        QString text = "QFluentWidgets startup timeline:";
+        for (const auto& timing : timeline()) {
+            text += QString("\n  %1 %2 [%3] %4 - %5 ms (%6 ms)%7")
+                .arg(timing.name, -12)
+                .arg(timing.critical ? "critical" : "deferred", -8)
+                .arg(timing.thread)
+                .arg(timing.startMs)
+                .arg(timing.endMs)
+                .arg(timing.finished ? timing.endMs - timing.startMs : -1)
+                .arg(timing.finished && !timing.succeeded ? " failed" : "");
+        }
+        return text;
+    }
+
+
+    QString StartupPipeline::stageName(Stage stage) {
+        switch (stage) {
+        case Stage::Theme:      return "theme";
+        case Stage::Font:       return "font";
+        case Stage::StyleSheet: return "stylesheet";
+        case Stage::Icon:       return "icon";
+        }
+        return QString();
+    }
+
+
+    void StartupPipeline::runStage(Stage stage, bool critical, const std::function<bool()>& task) {
+        int index = static_cast<int>(stage);
+        {
+            QMutexLocker locker(&mutex);
+            stages[index].critical = critical;
+            stages[index].thread = QThread::currentThread() == thread() ? "gui" : "worker";
+            stages[index].startMs = clock.elapsed();
+        }
+
+        bool ok = task();
+
+        {
+            QMutexLocker locker(&mutex);
+            stages[index].endMs = clock.elapsed();
+            stages[index].succeeded = ok;
+            stages[index].finished = true;
+            stageDone.wakeAll();
+        }
+
+        QMetaObject::invokeMethod(this, [this, stage] { onStageFinished(stage); }, Qt::QueuedConnection);
+    }
+
+
+    void StartupPipeline::runStageAsync(Stage stage, bool critical, const std::function<bool()>& task) {
+        {
+            QMutexLocker locker(&mutex);
+            stages[static_cast<int>(stage)].critical = critical;
+        }
+        pool.start([this, stage, critical, task] { runStage(stage, critical, task); });
+    }
+
+
+    bool StartupPipeline::waitFor(bool criticalOnly, int timeout) {
+        QDeadlineTimer deadline(timeout < 0 ? QDeadlineTimer::Forever : QDeadlineTimer(timeout));
+        QMutexLocker locker(&mutex);
+
+        while (true) {
+            bool done = true;
+            bool succeeded = true;
+            for (const auto& timing : stages) {
+                if (criticalOnly && !timing.critical) {
+                    continue;
+                }
+                done = done && timing.finished;
+                succeeded = succeeded && timing.succeeded;
+            }
+
+            if (done) {
+                return succeeded;
+            }
+
+            if (!stageDone.wait(&mutex, deadline)) {
+                return false;
+            }
+        }
+    }
+
+
+    void StartupPipeline::onStageFinished(Stage stage) {
+        qint64 elapsed;
+        {
+            QMutexLocker locker(&mutex);
+            elapsed = stages[static_cast<int>(stage)].endMs;
+        }
+        emit stageFinished(stageName(stage), elapsed);
+
+        if (!isFinished()) {
+            return;
+        }
+
+        if (qEnvironmentVariableIsSet("QFLUENT_STARTUP_TRACE")) {
+            qDebug().noquote() << report();
+        }
+        emit finished();
+    }
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <functional>
+
+namespace fluent {
+
+    // Cold-start warm-ups. The theme (qconfig, platform state and the theme
+    // snapshot) is set up on the GUI thread, everything else runs on worker
+    // threads in parallel with the construction of the first window.
+    class StartupPipeline : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        enum class Stage {
+            Theme,
+            Font,
+            StyleSheet,
+            Icon
+        };
+
+        struct StageTiming {
+            Stage stage;
+            QString name;
+            QString thread;
+            bool critical = false;
+            bool finished = false;
+            bool succeeded = false;
+            qint64 startMs = -1;
+            qint64 endMs = -1;
+        };
+
+        explicit StartupPipeline(QObject* parent = nullptr);
+        ~StartupPipeline();
+
+        void start();
+
+        // Blocks until the stages the first frame needs are done
+        bool waitForCritical(int timeout = -1);
+        bool waitForFinished(int timeout = -1);
+        bool isFinished() const;
+
+        QList<StageTiming> timeline() const;
+        QString report() const;
+
+        static QString stageName(Stage stage);
+
+    signals:
+        void stageFinished(const QString& name, qint64 elapsed);
+        void finished();
+
+    private:
+        QThreadPool pool;
+        QElapsedTimer clock;
+        mutable QMutex mutex;
+        QWaitCondition stageDone;
+        QList<StageTiming> stages;
+        bool started;
+
+        void runStage(Stage stage, bool critical, const std::function<bool()>& task);
+        void runStageAsync(Stage stage, bool critical, const std::function<bool()>& task);
+        bool waitFor(bool criticalOnly, int timeout);
+        void onStageFinished(Stage stage);
+    };
+
+}
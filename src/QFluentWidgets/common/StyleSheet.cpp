@@ -1,15 +1,24 @@
 #include "StyleSheet.hpp"
 #include "QFluentWidgets/common/Config.hpp"
-#include "QFluentWidgets/utils/os.hpp"
+#include "QFluentWidgets/common/ThemeState.hpp"
+#include "QFluentWidgets/common/ThemeSnapshot.hpp"
+#include "QFluentWidgets/common/EventDispatcher.hpp"
 
 #include <QWidget>
 #include <QPointer>
 #include <QEvent>
 #include <QDynamicPropertyChangeEvent>
 #include <QColor>
+#include <QHash>
+#include <QReadWriteLock>
 
 namespace fluent {
 
+    // Contents of qss files from the resources, which never change at runtime
+    static QReadWriteLock qssCacheLock;
+    static QHash<QString, QString> qssCache;
+
+
     QString StyleSheetBase::content(Theme::Mode theme) const {
         return getStyleSheetFromFile(path(theme));
     }
@@ -31,14 +40,16 @@ namespace fluent {
         LIGHT_3 = "ThemeColorLight3"
     */
     QString applyThemeColor(const QString& qss) {
-        static const std::unordered_map<QString, QString> mappings = {
-            {"ThemeColorPrimary", ThemeColorHelper::toQColor(ThemeColor::PRIMARY).name()},
-            {"ThemeColorDark1", ThemeColorHelper::toQColor(ThemeColor::DARK_1).name()},
-            {"ThemeColorDark2", ThemeColorHelper::toQColor(ThemeColor::DARK_2).name()},
-            {"ThemeColorDark3", ThemeColorHelper::toQColor(ThemeColor::DARK_3).name()},
-            {"ThemeColorLight1", ThemeColorHelper::toQColor(ThemeColor::LIGHT_1).name()},
-            {"ThemeColorLight2", ThemeColorHelper::toQColor(ThemeColor::LIGHT_2).name()},
-            {"ThemeColorLight3", ThemeColorHelper::toQColor(ThemeColor::LIGHT_3).name()}
+        // Resolved against a snapshot so it also works off the GUI thread
+        ThemeSnapshotPtr snapshot = ThemeSnapshot::current();
+        const std::unordered_map<QString, QString> mappings = {
+            {"ThemeColorPrimary", snapshot->color(ThemeColor::PRIMARY).name()},
+            {"ThemeColorDark1", snapshot->color(ThemeColor::DARK_1).name()},
+            {"ThemeColorDark2", snapshot->color(ThemeColor::DARK_2).name()},
+            {"ThemeColorDark3", snapshot->color(ThemeColor::DARK_3).name()},
+            {"ThemeColorLight1", snapshot->color(ThemeColor::LIGHT_1).name()},
+            {"ThemeColorLight2", snapshot->color(ThemeColor::LIGHT_2).name()},
+            {"ThemeColorLight3", snapshot->color(ThemeColor::LIGHT_3).name()}
         };
 
 
@@ -149,7 +160,7 @@ namespace fluent {
 
 
     void toggleTheme(bool save, bool lazy) {
-        Theme::Mode theme = os::isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light;
+        Theme::Mode theme = themeState()->isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light;
         setTheme(theme, save, lazy);
     }
 
@@ -172,12 +183,27 @@ namespace fluent {
 
 
     QString getStyleSheetFromFile(const QString& filePath) {
+        bool cacheable = filePath.startsWith(':');
+        if (cacheable) {
+            QReadLocker locker(&qssCacheLock);
+            auto it = qssCache.constFind(filePath);
+            if (it != qssCache.cend()) {
+                return *it;
+            }
+        }
+
         QFile file(filePath);
         if (!file.open(QFile::ReadOnly)) {
             throw std::runtime_error("Unable to open file: " + file.fileName().toStdString());
         }
         QTextStream in(&file);
-        return in.readAll();
+        QString content = in.readAll();
+
+        if (cacheable) {
+            QWriteLocker locker(&qssCacheLock);
+            qssCache.insert(filePath, content);
+        }
+        return content;
     }
 
     QString getStyleSheetFromFile(QFile& file) {
@@ -189,6 +215,19 @@ namespace fluent {
     }
 
 
+    void preloadStyleSheets(Theme::Mode theme) {
+        int last = static_cast<int>(FluentStyleSheet::Type::NAVIGATION_INTERFACE);
+        for (int i = 0; i <= last; ++i) {
+            try {
+                getStyleSheetFromFile(FluentStyleSheet(static_cast<FluentStyleSheet::Type>(i)).path(theme));
+            }
+            catch (const std::runtime_error& e) {
+                qWarning() << e.what();
+            }
+        }
+    }
+
+
     void setStyleSheet(
         QWidget* widget,
         const QString& src,
@@ -405,8 +444,15 @@ namespace fluent {
     ) {
         if (!widgets.contains(widget)) {
             QObject::connect(widget, &QWidget::destroyed, this, &StyleSheetManager::deregister);
-            widget->installEventFilter(new CustomStyleSheetWatcher(widget));
-            widget->installEventFilter(new DirtyStyleSheetWatcher(widget));
+            auto* dispatcher = WidgetEventDispatcher::of(widget);
+            auto* customWatcher = new CustomStyleSheetWatcher(widget);
+            auto* dirtyWatcher = new DirtyStyleSheetWatcher(widget);
+            dispatcher->subscribe(customWatcher, { QEvent::DynamicPropertyChange }, [customWatcher](QWidget* w, QEvent* e) {
+                return customWatcher->eventFilter(w, e);
+            });
+            dispatcher->subscribe(dirtyWatcher, { QEvent::Paint }, [dirtyWatcher](QWidget* w, QEvent* e) {
+                return dirtyWatcher->eventFilter(w, e);
+            });
             widgets.insert(widget, new StyleSheetCompose({ source, new CustomStyleSheet(widget) }));
         }
 
@@ -443,11 +489,15 @@ namespace fluent {
 
 
     QColor ThemeColorHelper::toQColor(ThemeColor color) {
-        QColor baseColor = getBaseColor();
+        return toQColor(color, getBaseColor(), isDarkTheme());
+    }
+
+
+    QColor ThemeColorHelper::toQColor(ThemeColor color, const QColor& baseColor, bool dark) {
         float h, s, v;
         baseColor.getHsvF(&h, &s, &v);
 
-        if (isDarkTheme()) {
+        if (dark) {
             s *= 0.84;
             v = 1.0;
             adjustDarkTheme(color, s, v);
@@ -466,7 +516,7 @@ namespace fluent {
 
 
     bool ThemeColorHelper::isDarkTheme() {
-        return fluent::os::isDarkTheme();
+        return themeState()->isDarkTheme();
     }
 
 
@@ -164,6 +164,7 @@ namespace fluent {
         static QString name(ThemeColor color);
 
         static QColor toQColor(ThemeColor color);
+        static QColor toQColor(ThemeColor color, const QColor& baseColor, bool dark);
 
     private:
         static QColor getBaseColor();
@@ -192,6 +193,7 @@ namespace fluent {
 
     QString getStyleSheetFromFile(const QString& filePath);
     QString getStyleSheetFromFile(QFile& file);
+    void preloadStyleSheets(Theme::Mode theme);
 
 
     void setStyleSheet(QWidget* widget, const QString& styleSheet, Theme::Mode theme = Theme::Mode::Auto, bool reg = true);
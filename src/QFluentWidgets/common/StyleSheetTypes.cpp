@@ -3,7 +3,7 @@
 #include <QString>
 #include "StyleSheet.hpp"
 
-#include "QFluentWidgets/utils/os.hpp"
+#include "QFluentWidgets/common/ThemeState.hpp"
 
 namespace fluent {
 
@@ -16,7 +16,7 @@ namespace fluent {
     QString FluentStyleSheet::path(Theme::Mode theme) const {
       // Assuming qconfig.theme is a global variable or a singleton
         if (theme == Theme::Mode::Auto) {
-          theme = fluent::os::isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light;
+          theme = themeState()->isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light;
         }
 
         static const std::unordered_map<Type, std::string> typeToString{
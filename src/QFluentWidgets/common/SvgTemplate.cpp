@@ -0,0 +1,196 @@
+#include "SvgTemplate.hpp"
+
+#include "QFluentWidgets/common/Icons.hpp"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <algorithm>
+
+namespace fluent {
+
+    static QReadWriteLock templateCacheLock;
+    static QHash<QString, SvgTemplate> templateCache;
+
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+
+    static QByteArray escapeAttribute(const QString& value) {
+        QByteArray escaped = value.toUtf8();
+        escaped.replace('&', "&amp;");
+        escaped.replace('<', "&lt;");
+        escaped.replace('"', "&quot;");
+        return escaped;
+    }
+
+
+    SvgTemplate::SvgTemplate(const QByteArray& source)
+        : m_source(source)
+    {
+        valid = !m_source.isEmpty() && scan();
+    }
+
+
+    bool SvgTemplate::scan() {
+        const char* data = m_source.constData();
+        const int size = m_source.size();
+        int pos = 0;
+
+        while (pos < size) {
+            int open = m_source.indexOf('<', pos);
+            if (open < 0) {
+                break;
+            }
+
+            if (m_source.mid(open, 4) == "<!--") {
+                int close = m_source.indexOf("-->", open + 4);
+                if (close < 0) {
+                    return false;
+                }
+                pos = close + 3;
+                continue;
+            }
+
+            pos = open + 1;
+            if (m_source.mid(open, 5) != "<path" || open + 5 >= size) {
+                continue;
+            }
+
+            char next = data[open + 5];
+            if (!isSpace(next) && next != '/' && next != '>') {
+                continue;
+            }
+
+            Element element;
+            element.insertAt = open + 5;
+            pos = open + 5;
+
+            while (true) {
+                while (pos < size && isSpace(data[pos])) {
+                    ++pos;
+                }
+                if (pos >= size) {
+                    return false;
+                }
+                if (data[pos] == '>' || data[pos] == '/') {
+                    break;
+                }
+
+                int nameBegin = pos;
+                while (pos < size && !isSpace(data[pos]) && data[pos] != '=' && data[pos] != '>' && data[pos] != '/') {
+                    ++pos;
+                }
+                QByteArray name = m_source.mid(nameBegin, pos - nameBegin);
+
+                while (pos < size && isSpace(data[pos])) {
+                    ++pos;
+                }
+                if (pos >= size || data[pos] != '=') {
+                    return false;
+                }
+                ++pos;
+                while (pos < size && isSpace(data[pos])) {
+                    ++pos;
+                }
+                if (pos >= size || (data[pos] != '"' && data[pos] != '\'')) {
+                    return false;
+                }
+
+                char quote = data[pos++];
+                int valueEnd = m_source.indexOf(quote, pos);
+                if (valueEnd < 0) {
+                    return false;
+                }
+
+                element.attributes.append({ name, pos, valueEnd });
+                pos = valueEnd + 1;
+            }
+
+            paths.append(element);
+        }
+
+        return true;
+    }
+
+
+    QByteArray SvgTemplate::apply(const QList<int>& indexes, const QMap<QString, QString>& attributes) const {
+        if (!valid || attributes.isEmpty()) {
+            return m_source;
+        }
+
+        struct Edit {
+            int begin;
+            int end;
+            QByteArray text;
+        };
+
+        QVector<Edit> edits;
+        auto edit = [&](int index) {
+            const Element& element = paths.at(index);
+            for (auto it = attributes.begin(); it != attributes.end(); ++it) {
+                QByteArray name = it.key().toUtf8();
+                QByteArray value = escapeAttribute(it.value());
+
+                auto found = std::find_if(element.attributes.begin(), element.attributes.end(),
+                    [&](const Attribute& attribute) { return attribute.name == name; });
+
+                if (found != element.attributes.end()) {
+                    edits.append({ found->valueBegin, found->valueEnd, value });
+                }
+                else {
+                    edits.append({ element.insertAt, element.insertAt, ' ' + name + "=\"" + value + '"' });
+                }
+            }
+        };
+
+        if (indexes.isEmpty()) {
+            for (int i = 0; i < paths.size(); ++i) {
+                edit(i);
+            }
+        }
+        else {
+            QVector<bool> seen(paths.size(), false);
+            for (int index : indexes) {
+                if (index >= 0 && index < paths.size() && !seen[index]) {
+                    seen[index] = true;
+                    edit(index);
+                }
+            }
+        }
+
+        std::stable_sort(edits.begin(), edits.end(), [](const Edit& a, const Edit& b) { return a.begin < b.begin; });
+
+        QByteArray result;
+        result.reserve(m_source.size() + edits.size() * 16);
+
+        int pos = 0;
+        for (const auto& e : edits) {
+            result.append(m_source.constData() + pos, e.begin - pos);
+            result.append(e.text);
+            pos = e.end;
+        }
+        result.append(m_source.constData() + pos, m_source.size() - pos);
+        return result;
+    }
+
+
+    SvgTemplate SvgTemplate::fromFile(const QString& iconPath) {
+        {
+            QReadLocker locker(&templateCacheLock);
+            auto it = templateCache.constFind(iconPath);
+            if (it != templateCache.cend()) {
+                return *it;
+            }
+        }
+
+        SvgTemplate svgTemplate(svgSource(iconPath));
+        if (iconPath.startsWith(':') && svgTemplate.isValid()) {
+            QWriteLocker locker(&templateCacheLock);
+            templateCache.insert(iconPath, svgTemplate);
+        }
+        return svgTemplate;
+    }
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QVector>
+
+namespace fluent {
+
+    // An svg file scanned once for the byte offsets of its <path> elements
+    // and their attribute values. Recoloring splices the new values into a
+    // copy of the source, there is no xml parse or serialization per call.
+    class SvgTemplate
+    {
+    public:
+        SvgTemplate() = default;
+        explicit SvgTemplate(const QByteArray& source);
+
+        bool isValid() const { return valid; }
+        int pathCount() const { return paths.size(); }
+        const QByteArray& source() const { return m_source; }
+
+        // Sets attributes on the paths at indexes, on every path if indexes is
+        // empty. Existing attributes are replaced, missing ones are added.
+        QByteArray apply(const QList<int>& indexes, const QMap<QString, QString>& attributes) const;
+
+        // Templates of resource files are kept for the lifetime of the process
+        static SvgTemplate fromFile(const QString& iconPath);
+
+    private:
+        struct Attribute {
+            QByteArray name;
+            int valueBegin;
+            int valueEnd;
+        };
+
+        struct Element {
+            int insertAt;
+            QVector<Attribute> attributes;
+        };
+
+        QByteArray m_source;
+        QVector<Element> paths;
+        bool valid = false;
+
+        bool scan();
+    };
+
+}
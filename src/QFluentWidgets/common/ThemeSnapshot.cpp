@@ -0,0 +1,110 @@
+#include "ThemeSnapshot.hpp"
+
+#include "QFluentWidgets/common/ThemeState.hpp"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QTimer>
+#include <QList>
+#include <atomic>
+
+namespace fluent {
+
+    // Readers bump activeReaders around "load pointer, take a reference", the
+    // GUI thread only drops its reference on retired snapshots while no reader
+    // is inside that window. Readers never block and never retry.
+    static std::atomic<const ThemeSnapshot*> currentSnapshot(nullptr);
+    static std::atomic<int> activeReaders(0);
+    static QList<const ThemeSnapshot*> retiredSnapshots;
+
+
+    static void reclaimRetired() {
+        if (retiredSnapshots.isEmpty()) {
+            return;
+        }
+
+        if (activeReaders.load() != 0) {
+            QTimer::singleShot(0, themeState(), &reclaimRetired);
+            return;
+        }
+
+        for (auto* snapshot : retiredSnapshots) {
+            if (!snapshot->ref.deref()) {
+                delete snapshot;
+            }
+        }
+        retiredSnapshots.clear();
+    }
+
+
+    static bool isGuiThread() {
+        auto* app = QCoreApplication::instance();
+        return app && QThread::currentThread() == app->thread();
+    }
+
+
+    ThemeSnapshot::ThemeSnapshot(Theme::Mode mode, bool dark, const QColor& baseColor)
+        : m_mode(mode), m_dark(dark), m_baseColor(baseColor)
+    {
+        for (int i = 0; i < int(m_palette.size()); ++i) {
+            m_palette[i] = ThemeColorHelper::toQColor(static_cast<ThemeColor>(i), baseColor, dark).rgba();
+        }
+    }
+
+
+    QColor ThemeSnapshot::color(ThemeColor color) const {
+        return QColor::fromRgba(m_palette[static_cast<int>(color)]);
+    }
+
+
+    QString ThemeSnapshot::iconColor(bool reverse) const {
+        return m_dark != reverse ? "white" : "black";
+    }
+
+
+    ThemeSnapshotPtr ThemeSnapshot::current() {
+        activeReaders.fetch_add(1);
+        ThemeSnapshotPtr snapshot(currentSnapshot.load());
+        activeReaders.fetch_sub(1);
+
+        if (snapshot) {
+            return snapshot;
+        }
+
+        // Nothing published yet: the GUI thread can build the first one,
+        // other threads must not touch qconfig and get the defaults.
+        if (isGuiThread()) {
+            publish();
+            return ThemeSnapshotPtr(currentSnapshot.load());
+        }
+
+        static const ThemeSnapshotPtr fallback(new ThemeSnapshot(Theme::Mode::Light, false, QColor("#009faa")));
+        return fallback;
+    }
+
+
+    void ThemeSnapshot::publish() {
+        Q_ASSERT(isGuiThread());
+
+        static bool connected = false;
+        if (!connected) {
+            connected = true;
+            QObject::connect(qconfig->themeMode, &ConfigItem::valueChanged, themeState(), &ThemeSnapshot::publish);
+            QObject::connect(qconfig->themeColor, &ConfigItem::valueChanged, themeState(), &ThemeSnapshot::publish);
+            QObject::connect(themeState(), &ThemeState::changed, themeState(), &ThemeSnapshot::publish);
+        }
+
+        // Light and Dark are taken as configured, only Auto follows the OS
+        Theme::Mode mode = theme();
+        bool dark = mode == Theme::Mode::Auto ? themeState()->isDarkTheme() : mode == Theme::Mode::Dark;
+
+        auto* snapshot = new ThemeSnapshot(mode, dark, qconfig->themeColor->value().value<QColor>());
+        snapshot->ref.ref();
+
+        if (auto* previous = currentSnapshot.exchange(snapshot)) {
+            retiredSnapshots.append(previous);
+        }
+        reclaimRetired();
+    }
+
+}
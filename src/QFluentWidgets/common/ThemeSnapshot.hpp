@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QColor>
+#include <QString>
+#include <QSharedData>
+#include <QExplicitlySharedDataPointer>
+#include <array>
+
+#include "QFluentWidgets/common/Config.hpp"
+#include "QFluentWidgets/common/StyleSheet.hpp"
+
+namespace fluent {
+
+    class ThemeSnapshot;
+    using ThemeSnapshotPtr = QExplicitlySharedDataPointer<const ThemeSnapshot>;
+
+
+    // Immutable copy of the theme, republished on the GUI thread whenever the
+    // theme mode, theme color or platform theme changes. current() is lock-free
+    // and may be called from any thread, e.g. to rasterize icons or blur.
+    class ThemeSnapshot : public QSharedData
+    {
+    public:
+        ThemeSnapshot(Theme::Mode mode, bool dark, const QColor& baseColor);
+
+        Theme::Mode mode() const { return m_mode; }
+        bool isDarkTheme() const { return m_dark; }
+        QColor baseColor() const { return m_baseColor; }
+
+        QColor color(ThemeColor color) const;
+        QString iconColor(bool reverse = false) const;
+
+        static ThemeSnapshotPtr current();
+        static void publish();
+
+    private:
+        const Theme::Mode m_mode;
+        const bool m_dark;
+        const QColor m_baseColor;
+        std::array<QRgb, 7> m_palette;
+    };
+
+}
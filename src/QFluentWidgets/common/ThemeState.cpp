@@ -0,0 +1,132 @@
+#include "ThemeState.hpp"
+
+#include "QFluentWidgets/utils/OS.hpp"
+
+#include <QGuiApplication>
+#include <QStyleHints>
+#include <QMetaObject>
+
+namespace fluent {
+
+    Q_GLOBAL_STATIC(ThemeState, globalThemeState);
+
+
+    static QRgb queryAccentColor() {
+        auto vcc = os::getPrimaryColor();
+        QColor color;
+        color.setRgbF(vcc.r, vcc.g, vcc.b, vcc.a);
+        return color.rgba();
+    }
+
+
+    static void onPlatformThemeChanged() {
+        QMetaObject::invokeMethod(themeState(), &ThemeState::refresh, Qt::QueuedConnection);
+    }
+
+
+    ThemeState::ThemeState(QObject* parent)
+        : QObject(parent), m_darkTheme(os::isDarkTheme()), m_accentColor(queryAccentColor()), m_refreshPending(false)
+    {
+        os::setThemeChangedCallback(&onPlatformThemeChanged);
+
+        if (QCoreApplication::instance()) {
+            attachApplication(false);
+        }
+        else {
+            qAddPreRoutine(&ThemeState::attachOnStartup);
+        }
+    }
+
+
+    void ThemeState::attachApplication(bool starting) {
+        QCoreApplication::instance()->installEventFilter(this);
+
+        // The style hints only exist once the application is constructed, the
+        // platform may also have changed since the state was read
+        if (starting) {
+            QMetaObject::invokeMethod(this, [this] {
+                connectStyleHints();
+                refresh();
+            }, Qt::QueuedConnection);
+        }
+        else {
+            connectStyleHints();
+        }
+    }
+
+
+    // Runs inside the application constructor when the state was created first
+    void ThemeState::attachOnStartup() {
+        themeState()->attachApplication(true);
+    }
+
+
+    void ThemeState::connectStyleHints() {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+        if (qobject_cast<QGuiApplication*>(QCoreApplication::instance())) {
+            connect(QGuiApplication::styleHints(), &QStyleHints::colorSchemeChanged, this, &ThemeState::scheduleRefresh);
+        }
+#endif
+    }
+
+
+    bool ThemeState::isDarkTheme() const {
+        return m_darkTheme.load(std::memory_order_relaxed);
+    }
+
+
+    QColor ThemeState::accentColor() const {
+        return QColor::fromRgba(m_accentColor.load(std::memory_order_relaxed));
+    }
+
+
+    void ThemeState::refresh() {
+        m_refreshPending.store(false);
+
+        bool dark = os::isDarkTheme();
+        QRgb accent = queryAccentColor();
+
+        bool darkChanged = m_darkTheme.exchange(dark) != dark;
+        bool accentChanged = m_accentColor.exchange(accent) != accent;
+
+        if (darkChanged) {
+            emit darkThemeChanged(dark);
+        }
+
+        if (accentChanged) {
+            emit accentColorChanged(QColor::fromRgba(accent));
+        }
+
+        if (darkChanged || accentChanged) {
+            emit changed();
+        }
+    }
+
+
+    bool ThemeState::eventFilter(QObject* watched, QEvent* event) {
+        switch (event->type()) {
+        case QEvent::ThemeChange:
+        case QEvent::ApplicationPaletteChange:
+            scheduleRefresh();
+            break;
+        default:
+            break;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+
+    void ThemeState::scheduleRefresh() {
+        // A theme change is delivered to every window, only query the OS once
+        if (m_refreshPending.exchange(true)) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, &ThemeState::refresh, Qt::QueuedConnection);
+    }
+
+
+    ThemeState* themeState() {
+        return globalThemeState();
+    }
+
+} // namespace fluent
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QObject>
+#include <QColor>
+#include <QEvent>
+#include <atomic>
+
+namespace fluent {
+
+    // Cached platform theme state. The OS is only queried when the platform
+    // reports a theme or palette change, paint paths read the atomics.
+    class ThemeState : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit ThemeState(QObject* parent = nullptr);
+
+        bool isDarkTheme() const;
+        QColor accentColor() const;
+
+    public slots:
+        void refresh();
+
+    signals:
+        void darkThemeChanged(bool dark);
+        void accentColorChanged(const QColor& color);
+        void changed();
+
+    protected:
+        bool eventFilter(QObject* watched, QEvent* event) override;
+
+    private:
+        std::atomic<bool> m_darkTheme;
+        std::atomic<QRgb> m_accentColor;
+        std::atomic<bool> m_refreshPending;
+
+        void scheduleRefresh();
+        void attachApplication(bool starting);
+        void connectStyleHints();
+
+        static void attachOnStartup();
+    };
+
+
+    ThemeState* themeState();
+
+}
@@ -0,0 +1,69 @@
+#include "TypedAnimation.hpp"
+
+#include "QFluentWidgets/common/AnimationDriver.hpp"
+#include "QFluentWidgets/common/MotionPolicy.hpp"
+#include "QFluentWidgets/common/AnimationProfiler.hpp"
+
+namespace fluent {
+
+    TypedAnimationBase::TypedAnimationBase(QObject* parent)
+        : QAbstractAnimation(parent), m_duration(250), lastApplied(0), m_role(AnimationRole::Decorative)
+    {
+        animationDriver();
+    }
+
+
+    int TypedAnimationBase::duration() const {
+        return isInstantMotion(m_role) ? 0 : m_duration;
+    }
+
+
+    void TypedAnimationBase::setDuration(int msecs) {
+        m_duration = qMax(0, msecs);
+    }
+
+
+    QEasingCurve TypedAnimationBase::easingCurve() const {
+        return m_easingCurve;
+    }
+
+
+    void TypedAnimationBase::setEasingCurve(const QEasingCurve& curve) {
+        m_easingCurve = curve;
+    }
+
+
+    void TypedAnimationBase::setMotion(FluentAnimationType aniType, FluentAnimationSpeed speed) {
+        const MotionPreset& preset = motion::presets[static_cast<int>(aniType)];
+        setDuration(preset.durations[static_cast<int>(speed)]);
+        setEasingCurve(FluentAnimation::curve(aniType));
+    }
+
+
+    void TypedAnimationBase::setUpdateWidget(QWidget* widget) {
+        updateWidget = widget;
+    }
+
+
+    void TypedAnimationBase::updateCurrentTime(int currentTime) {
+        int total = duration();
+        if (animationQuality()->skipTick(m_role, currentTime, lastApplied, total)) {
+            return;
+        }
+
+        qreal progress = total > 0 ? qreal(currentTime) / total : 1;
+        applyProgress(m_easingCurve.valueForProgress(progress));
+
+        if (updateWidget) {
+            animationDriver()->scheduleUpdate(updateWidget);
+        }
+        animationProfiler()->ticked(this);
+    }
+
+
+    void TypedAnimationBase::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) {
+        animationProfiler()->stateChanged(this, updateWidget ? updateWidget.data() : parent(), newState);
+        QAbstractAnimation::updateState(newState, oldState);
+    }
+
+}
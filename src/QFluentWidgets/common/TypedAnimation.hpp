@@ -0,0 +1,204 @@
+#pragma once
+
+#include <QAbstractAnimation>
+#include <QEasingCurve>
+#include <QPointer>
+#include <QWidget>
+#include <QColor>
+#include <QPoint>
+#include <QPointF>
+#include <QSize>
+#include <QSizeF>
+#include <QRect>
+#include <QRectF>
+#include <QtMath>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "QFluentWidgets/common/Animations.hpp"
+
+namespace fluent {
+
+    // Linear interpolation of the animated types, specialize it for new ones
+    template <typename T, typename = void>
+    struct AnimationTraits {
+        static T lerp(const T& from, const T& to, qreal progress) {
+            return from + (to - from) * progress;
+        }
+    };
+
+
+    template <typename T>
+    struct AnimationTraits<T, std::enable_if_t<std::is_integral_v<T>>> {
+        static T lerp(const T& from, const T& to, qreal progress) {
+            return T(qRound(from + (to - from) * progress));
+        }
+    };
+
+
+    template <>
+    struct AnimationTraits<QPoint> {
+        static QPoint lerp(const QPoint& from, const QPoint& to, qreal progress) {
+            return from + (QPointF(to - from) * progress).toPoint();
+        }
+    };
+
+
+    template <>
+    struct AnimationTraits<QSize> {
+        static QSize lerp(const QSize& from, const QSize& to, qreal progress) {
+            return QSize(AnimationTraits<int>::lerp(from.width(), to.width(), progress),
+                AnimationTraits<int>::lerp(from.height(), to.height(), progress));
+        }
+    };
+
+
+    template <>
+    struct AnimationTraits<QSizeF> {
+        static QSizeF lerp(const QSizeF& from, const QSizeF& to, qreal progress) {
+            return from + (to - from) * progress;
+        }
+    };
+
+
+    template <>
+    struct AnimationTraits<QRectF> {
+        static QRectF lerp(const QRectF& from, const QRectF& to, qreal progress) {
+            return QRectF(AnimationTraits<QPointF>::lerp(from.topLeft(), to.topLeft(), progress),
+                AnimationTraits<QSizeF>::lerp(from.size(), to.size(), progress));
+        }
+    };
+
+
+    template <>
+    struct AnimationTraits<QRect> {
+        static QRect lerp(const QRect& from, const QRect& to, qreal progress) {
+            return QRect(AnimationTraits<QPoint>::lerp(from.topLeft(), to.topLeft(), progress),
+                AnimationTraits<QSize>::lerp(from.size(), to.size(), progress));
+        }
+    };
+
+
+    template <>
+    struct AnimationTraits<QColor> {
+        static QColor lerp(const QColor& from, const QColor& to, qreal progress) {
+            QRgb a = from.rgba();
+            QRgb b = to.rgba();
+
+            // Overshooting curves leave [0, 1], QColor rejects the channels
+            auto channel = [progress](int from, int to) {
+                return qBound(0, AnimationTraits<int>::lerp(from, to, progress), 255);
+            };
+            return QColor(
+                channel(qRed(a), qRed(b)),
+                channel(qGreen(a), qGreen(b)),
+                channel(qBlue(a), qBlue(b)),
+                channel(qAlpha(a), qAlpha(b))
+            );
+        }
+    };
+
+
+    // Non-template part: timing, easing and the optional repaint target
+    class TypedAnimationBase : public QAbstractAnimation
+    {
+        Q_OBJECT
+
+    public:
+        explicit TypedAnimationBase(QObject* parent = nullptr);
+
+        int duration() const override;
+        void setDuration(int msecs);
+
+        QEasingCurve easingCurve() const;
+        void setEasingCurve(const QEasingCurve& curve);
+
+        // Duration and curve of a Fluent motion preset
+        void setMotion(FluentAnimationType aniType, FluentAnimationSpeed speed = FluentAnimationSpeed::FAST);
+
+        // Widget repainted through the animation driver after each write
+        void setUpdateWidget(QWidget* widget);
+
+        AnimationRole role() const { return m_role; }
+        void setRole(AnimationRole role) { m_role = role; }
+
+    protected:
+        void updateCurrentTime(int currentTime) override;
+        void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState) override;
+        virtual void applyProgress(qreal progress) = 0;
+
+    private:
+        int m_duration;
+        int lastApplied;
+        AnimationRole m_role;
+        QEasingCurve m_easingCurve;
+        QPointer<QWidget> updateWidget;
+    };
+
+
+    // Animation writing T straight through a setter or a member pointer,
+    // without QVariant boxing or meta-object property lookups
+    template <typename T>
+    class TypedAnimation : public TypedAnimationBase
+    {
+    public:
+        using Setter = std::function<void(const T&)>;
+
+        explicit TypedAnimation(Setter setter, QObject* parent = nullptr)
+            : TypedAnimationBase(parent), setter(std::move(setter)), m_startValue(), m_endValue(), m_currentValue()
+        {}
+
+        template <typename Obj, typename Arg>
+        TypedAnimation(Obj* obj, void (Obj::*method)(Arg), QObject* parent = nullptr)
+            : TypedAnimation([obj, method](const T& value) { (obj->*method)(value); }, parent)
+        {}
+
+        template <typename Obj>
+        TypedAnimation(Obj* obj, T Obj::*member, QObject* parent = nullptr)
+            : TypedAnimation([obj, member](const T& value) { obj->*member = value; }, parent)
+        {}
+
+        T startValue() const { return m_startValue; }
+        void setStartValue(const T& value) { m_startValue = value; }
+
+        T endValue() const { return m_endValue; }
+        void setEndValue(const T& value) { m_endValue = value; }
+
+        T currentValue() const { return m_currentValue; }
+
+        // Restarts from the current value, like FluentAnimation::startAnimation
+        void startAnimation(const T& endValue) {
+            startAnimation(endValue, m_currentValue);
+        }
+
+        void startAnimation(const T& endValue, const T& startValue) {
+            stop();
+            m_startValue = startValue;
+            m_endValue = endValue;
+            start();
+        }
+
+    protected:
+        void applyProgress(qreal progress) override {
+            m_currentValue = AnimationTraits<T>::lerp(m_startValue, m_endValue, progress);
+            setter(m_currentValue);
+        }
+
+    private:
+        Setter setter;
+        T m_startValue;
+        T m_endValue;
+        T m_currentValue;
+    };
+
+
+    template <typename T, typename Setter>
+    TypedAnimation<T>* FluentAnimation::createTyped(FluentAnimationType aniType, Setter setter,
+        FluentAnimationSpeed speed, QObject* parent) {
+        auto* ani = new TypedAnimation<T>(typename TypedAnimation<T>::Setter(std::move(setter)), parent);
+        ani->setMotion(aniType, speed);
+        return ani;
+    }
+
+}
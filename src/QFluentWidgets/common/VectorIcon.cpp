@@ -0,0 +1,127 @@
+#include "VectorIcon.hpp"
+
+#include "VectorIconData.hpp"
+#include "FluentIconTypes.hpp"
+
+#include <QImage>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace fluent {
+
+    // Both are generated from the same icons in the same order, so an
+    // IconType is also an index into the vector icons
+    static_assert(icondata::iconCount == icondata::count, "icon tables out of sync");
+
+
+    static QPainterPath buildPath(const icondata::Entry& entry) {
+        constexpr qreal scale = 1.0 / icondata::unit;
+        const std::uint8_t* command = icondata::commands + entry.firstCommand;
+        const std::int16_t* c = icondata::coords + entry.firstCoord;
+
+        QPainterPath path;
+        path.setFillRule(entry.evenOdd ? Qt::OddEvenFill : Qt::WindingFill);
+
+        for (std::uint32_t i = 0; i < entry.commandCount; ++i) {
+            switch (command[i]) {
+            case icondata::MoveTo:
+                path.moveTo(c[0] * scale, c[1] * scale);
+                c += 2;
+                break;
+            case icondata::LineTo:
+                path.lineTo(c[0] * scale, c[1] * scale);
+                c += 2;
+                break;
+            case icondata::QuadTo:
+                path.quadTo(c[0] * scale, c[1] * scale, c[2] * scale, c[3] * scale);
+                c += 4;
+                break;
+            case icondata::CubicTo:
+                path.cubicTo(c[0] * scale, c[1] * scale, c[2] * scale, c[3] * scale, c[4] * scale, c[5] * scale);
+                c += 6;
+                break;
+            case icondata::Close:
+                path.closeSubpath();
+                break;
+            }
+        }
+        return path;
+    }
+
+
+    static const std::vector<QPainterPath>& paths() {
+        static const std::vector<QPainterPath> built = [] {
+            std::vector<QPainterPath> result;
+            result.reserve(icondata::count);
+            for (const auto& entry : icondata::entries) {
+                result.push_back(buildPath(entry));
+            }
+            return result;
+        }();
+        return built;
+    }
+
+
+    int VectorIcon::count() {
+        return icondata::count;
+    }
+
+
+    int VectorIcon::indexOf(const QString& name) {
+        QByteArray key = name.toLatin1();
+        auto begin = std::begin(icondata::entries);
+        auto end = std::end(icondata::entries);
+        auto it = std::lower_bound(begin, end, key, [](const icondata::Entry& entry, const QByteArray& key) {
+            return std::strcmp(entry.name, key.constData()) < 0;
+        });
+
+        if (it == end || key != it->name) {
+            return -1;
+        }
+        return int(it - begin);
+    }
+
+
+    QString VectorIcon::name(int index) {
+        if (index < 0 || index >= icondata::count) {
+            return QString();
+        }
+        return QString::fromLatin1(icondata::entries[index].name);
+    }
+
+
+    const QPainterPath& VectorIcon::path(int index) {
+        static const QPainterPath empty;
+        if (index < 0 || index >= icondata::count) {
+            return empty;
+        }
+        return paths()[index];
+    }
+
+
+    void VectorIcon::paint(QPainter* painter, const QRectF& rect, int index, const QBrush& brush) {
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->translate(rect.topLeft());
+        painter->scale(rect.width(), rect.height());
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(brush);
+        painter->drawPath(path(index));
+        painter->restore();
+    }
+
+
+    QImage VectorIcon::image(int index, const QSize& size, qreal dpr, const QColor& color, qreal opacity) {
+        QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(dpr);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        painter.setOpacity(opacity);
+        paint(&painter, QRectF(QPointF(0, 0), QSizeF(size)), index, color);
+        painter.end();
+        return image;
+    }
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QImage>
+#include <QString>
+#include <QColor>
+#include <QBrush>
+#include <QRectF>
+
+namespace fluent {
+
+    // The built-in icons compiled to path data by tools/IconCompiler at build
+    // time. Each icon is one filled path in the unit square, the color comes
+    // from the brush, so there is a single variant for every theme and tint.
+    class VectorIcon
+    {
+    public:
+        static int count();
+
+        // -1 if there is no compiled icon with this name
+        static int indexOf(const QString& name);
+        static QString name(int index);
+
+        // Built once for all icons on first use, safe to use from any thread
+        static const QPainterPath& path(int index);
+
+        static void paint(QPainter* painter, const QRectF& rect, int index, const QBrush& brush);
+        static QImage image(int index, const QSize& size, qreal dpr, const QColor& color, qreal opacity = 1.0);
+    };
+
+}
@@ -3,7 +3,7 @@
 #include "QFluentWidgets/common/StyleSheet.hpp"
 #include "QFluentWidgets/common/Font.hpp"
 #include "QFluentWidgets/common/Icons.hpp"
-#include <QFluentWidgets/utils/OS.hpp>
+#include "QFluentWidgets/common/ThemeState.hpp"
 #include <QDesktopServices>
 
 #include <QPainter>
@@ -154,11 +154,11 @@ void PrimaryPushButton::selfDrawIcon(
     QIcon::State state
 ) {
     if (!f_icon.isNull()) {
-        Theme::Mode tt = os::isDarkTheme() ? Theme::Mode::Light : Theme::Mode::Dark;
+        Theme::Mode tt = themeState()->isDarkTheme() ? Theme::Mode::Light : Theme::Mode::Dark;
         m_icon = f_icon.icon(tt);
     }
     else if (isEnabled()) {
-        painter->setOpacity(fluent::os::isDarkTheme() ? 0.786 : 0.9);
+        painter->setOpacity(themeState()->isDarkTheme() ? 0.786 : 0.9);
         if (!f_icon.isNull())
             m_icon = f_icon.icon(Theme::Mode::Dark);
     }
@@ -194,7 +194,7 @@ void ToggleButton::selfDrawIcon(
 ) {
     if (!isChecked()) {
         if (!f_icon.isNull()) {
-            Theme::Mode tt = os::isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light;
+            Theme::Mode tt = themeState()->isDarkTheme() ? Theme::Mode::Dark : Theme::Mode::Light;
             m_icon = f_icon.icon(tt);
         }
         PushButton::selfDrawIcon(icon, painter, rect);
@@ -202,11 +202,11 @@ void ToggleButton::selfDrawIcon(
     }
 
     if (!f_icon.isNull()) {
-        Theme::Mode tt = os::isDarkTheme() ? Theme::Mode::Light : Theme::Mode::Dark;
+        Theme::Mode tt = themeState()->isDarkTheme() ? Theme::Mode::Light : Theme::Mode::Dark;
         m_icon = f_icon.icon(tt);
     }
     else if (isEnabled()) {
-        painter->setOpacity(fluent::os::isDarkTheme() ? 0.786 : 0.9);
+        painter->setOpacity(themeState()->isDarkTheme() ? 0.786 : 0.9);
         if (!f_icon.isNull())
             m_icon = f_icon.icon(Theme::Mode::Dark);
     }
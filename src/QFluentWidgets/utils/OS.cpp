@@ -33,11 +33,16 @@ namespace fluent::os {
     { 
         DWORD highlightColor = GetSysColor(COLOR_HIGHLIGHT);
 
-        int red = GetRValue(highlightColor);
-        int green = GetGValue(highlightColor);
-        int blue = GetBValue(highlightColor);
+        float red = GetRValue(highlightColor) / 255.0f;
+        float green = GetGValue(highlightColor) / 255.0f;
+        float blue = GetBValue(highlightColor) / 255.0f;
 
-        return v_color { .r = red, .g = green, .b = blue };
+        return v_color { .r = red, .g = green, .b = blue, .a = 1.0f };
+    }
+
+
+    void setThemeChangedCallback(theme_callback) {
+        // WM_SETTINGCHANGE already reaches Qt as a ThemeChange event
     }
 
 }
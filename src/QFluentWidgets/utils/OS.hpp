@@ -1,9 +1,9 @@
 #pragma once
 
-namespace fluent { 
+namespace fluent {
     namespace os {
         bool isDarkTheme();
-        
+
         typedef struct {
             float r;
             float g;
@@ -12,5 +12,11 @@ namespace fluent {
         } v_color;
 
         v_color getPrimaryColor();
-    } 
+
+        // Called when the backend learns about a theme change that Qt does
+        // not deliver as a ThemeChange event (e.g. the Linux settings portal).
+        typedef void (*theme_callback)();
+
+        void setThemeChangedCallback(theme_callback callback);
+    }
 }
\ No newline at end of file
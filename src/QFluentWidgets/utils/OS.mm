@@ -30,6 +30,10 @@ namespace fluent::os {
             return color;
         }
     }
+
+    void setThemeChangedCallback(theme_callback) {
+        // Appearance changes already reach Qt as a ThemeChange event
+    }
 }
 
 #endif
\ No newline at end of file
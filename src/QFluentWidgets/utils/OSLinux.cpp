@@ -0,0 +1,192 @@
+#if defined(__linux__) && !defined(__ANDROID__)
+
+#include "OS.hpp"
+
+#include <QObject>
+#include <QCoreApplication>
+#include <QThread>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QDBusPendingCallWatcher>
+#include <QDBusVariant>
+#include <QDBusArgument>
+#include <atomic>
+
+namespace fluent::os {
+
+    // org.freedesktop.portal.Settings, see
+    // https://flatpak.github.io/xdg-desktop-portal/docs/doc-org.freedesktop.portal.Settings.html
+    static const char* PORTAL_SERVICE = "org.freedesktop.portal.Desktop";
+    static const char* PORTAL_PATH = "/org/freedesktop/portal/desktop";
+    static const char* PORTAL_INTERFACE = "org.freedesktop.portal.Settings";
+    static const char* APPEARANCE_NAMESPACE = "org.freedesktop.appearance";
+    static const char* COLOR_SCHEME_KEY = "color-scheme";
+    static const char* ACCENT_COLOR_KEY = "accent-color";
+
+    // Give up on the portal quickly and keep the defaults
+    static const int PORTAL_TIMEOUT = 500;
+
+    // Default Fluent theme color (#009faa), used until the portal answers
+    static const quint32 DEFAULT_ACCENT_COLOR = 0x009faaff;
+
+    static std::atomic<bool> darkTheme(false);
+    static std::atomic<quint32> accentColor(DEFAULT_ACCENT_COLOR);
+    static std::atomic<theme_callback> themeChangedCallback(nullptr);
+
+
+    class PortalSettings : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit PortalSettings(QObject* parent = nullptr);
+
+    public slots:
+        void onSettingChanged(const QString& ns, const QString& key, const QDBusVariant& value);
+
+    private:
+        QString service;
+
+        void read(const QString& key);
+        bool apply(const QString& key, const QVariant& value);
+    };
+
+
+    static QVariant unwrapVariant(QVariant value) {
+        // Read() wraps the setting in one more variant than ReadOne()
+        while (value.metaType() == QMetaType::fromType<QDBusVariant>()) {
+            value = value.value<QDBusVariant>().variant();
+        }
+        return value;
+    }
+
+
+    static quint32 packColor(double r, double g, double b) {
+        return (quint32(r * 255 + 0.5) << 24) | (quint32(g * 255 + 0.5) << 16) | (quint32(b * 255 + 0.5) << 8) | 0xff;
+    }
+
+
+    static void notifyThemeChanged() {
+        if (auto callback = themeChangedCallback.load()) {
+            callback();
+        }
+    }
+
+
+    PortalSettings::PortalSettings(QObject* parent)
+        : QObject(parent)
+    {
+        // Allows pointing the backend at a stand-in service, e.g. in tests
+        QByteArray override = qgetenv("QFLUENT_PORTAL_SERVICE");
+        service = override.isEmpty() ? QString(PORTAL_SERVICE) : QString::fromUtf8(override);
+
+        QDBusConnection bus = QDBusConnection::sessionBus();
+        if (!bus.isConnected()) {
+            return;
+        }
+
+        bus.connect(service, PORTAL_PATH, PORTAL_INTERFACE, "SettingChanged",
+            this, SLOT(onSettingChanged(QString, QString, QDBusVariant)));
+
+        read(COLOR_SCHEME_KEY);
+        read(ACCENT_COLOR_KEY);
+    }
+
+
+    void PortalSettings::onSettingChanged(const QString& ns, const QString& key, const QDBusVariant& value) {
+        if (ns != APPEARANCE_NAMESPACE) {
+            return;
+        }
+
+        if (apply(key, value.variant())) {
+            notifyThemeChanged();
+        }
+    }
+
+
+    void PortalSettings::read(const QString& key) {
+        QDBusMessage message = QDBusMessage::createMethodCall(service, PORTAL_PATH, PORTAL_INTERFACE, "Read");
+        message << QString(APPEARANCE_NAMESPACE) << key;
+
+        auto* watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message, PORTAL_TIMEOUT), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, key](QDBusPendingCallWatcher* watcher) {
+            QDBusMessage reply = watcher->reply();
+            if (reply.type() == QDBusMessage::ReplyMessage && !reply.arguments().isEmpty()) {
+                if (apply(key, reply.arguments().constFirst())) {
+                    notifyThemeChanged();
+                }
+            }
+            watcher->deleteLater();
+        });
+    }
+
+
+    bool PortalSettings::apply(const QString& key, const QVariant& value) {
+        QVariant setting = unwrapVariant(value);
+
+        if (key == COLOR_SCHEME_KEY) {
+            // 0: no preference, 1: prefer dark, 2: prefer light
+            bool dark = setting.toUInt() == 1;
+            return darkTheme.exchange(dark) != dark;
+        }
+
+        if (key == ACCENT_COLOR_KEY && setting.metaType() == QMetaType::fromType<QDBusArgument>()) {
+            double r = -1, g = -1, b = -1;
+            const QDBusArgument arg = setting.value<QDBusArgument>();
+            arg.beginStructure();
+            arg >> r >> g >> b;
+            arg.endStructure();
+
+            // Out of range channels mean the accent color is unset
+            quint32 color = DEFAULT_ACCENT_COLOR;
+            if (r >= 0 && r <= 1 && g >= 0 && g <= 1 && b >= 0 && b <= 1) {
+                color = packColor(r, g, b);
+            }
+            return accentColor.exchange(color) != color;
+        }
+
+        return false;
+    }
+
+
+    static void ensurePortal() {
+        static std::atomic<bool> started(false);
+
+        // The portal object needs the GUI thread's event loop for its replies
+        auto* app = QCoreApplication::instance();
+        if (!app || QThread::currentThread() != app->thread() || started.exchange(true)) {
+            return;
+        }
+
+        new PortalSettings(app);
+    }
+
+
+    bool isDarkTheme() {
+        ensurePortal();
+        return darkTheme.load();
+    }
+
+
+    v_color getPrimaryColor() {
+        ensurePortal();
+        quint32 color = accentColor.load();
+        return v_color {
+            .r = ((color >> 24) & 0xff) / 255.0f,
+            .g = ((color >> 16) & 0xff) / 255.0f,
+            .b = ((color >> 8) & 0xff) / 255.0f,
+            .a = (color & 0xff) / 255.0f
+        };
+    }
+
+
+    void setThemeChangedCallback(theme_callback callback) {
+        themeChangedCallback.store(callback);
+    }
+
+}
+
+#include "OSLinux.moc"
+
+#endif
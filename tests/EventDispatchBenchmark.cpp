@@ -0,0 +1,108 @@
+#include <QtTest>
+#include <QWidget>
+#include <QMouseEvent>
+#include <memory>
+#include <vector>
+
+#include "QFluentWidgets/common/EventDispatcher.hpp"
+
+using namespace fluent;
+
+// The event types the Fluent helpers watch on a widget: the custom and the
+// dirty style sheet watchers, the drop shadow and the animations
+static const std::vector<std::vector<QEvent::Type>> watchedTypes {
+    { QEvent::DynamicPropertyChange },
+    { QEvent::Paint },
+    { QEvent::Move, QEvent::Resize, QEvent::Show, QEvent::Hide, QEvent::ZOrderChange },
+    { QEvent::MouseButtonPress, QEvent::MouseButtonRelease, QEvent::Enter, QEvent::Leave },
+};
+
+
+// A helper as it was before the dispatcher, with its own filter on the widget
+class StackedFilter : public QObject
+{
+public:
+    explicit StackedFilter(const std::vector<QEvent::Type>& types)
+        : types(types)
+    {}
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override {
+        for (auto type : types) {
+            if (event->type() == type) {
+                return false;
+            }
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    std::vector<QEvent::Type> types;
+};
+
+
+// Cost per event of N helpers watching one widget, as N stacked event
+// filters and as N subscribers of one WidgetEventDispatcher
+class EventDispatchBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dispatch_data();
+    void dispatch();
+};
+
+
+void EventDispatchBenchmark::dispatch_data() {
+    QTest::addColumn<int>("helpers");
+    QTest::addColumn<bool>("dispatcher");
+    QTest::addColumn<int>("eventType");
+
+    // A mouse move nobody watches and an Enter one helper handles
+    for (auto type : { QEvent::MouseMove, QEvent::Enter }) {
+        const char* event = type == QEvent::MouseMove ? "move" : "enter";
+        QTest::addRow("%s, no helper", event) << 0 << false << int(type);
+        for (int helpers : { 1, 4, 8 }) {
+            QTest::addRow("%s, %d stacked filters", event, helpers) << helpers << false << int(type);
+            QTest::addRow("%s, %d dispatcher subscribers", event, helpers) << helpers << true << int(type);
+        }
+    }
+}
+
+
+void EventDispatchBenchmark::dispatch() {
+    QFETCH(int, helpers);
+    QFETCH(bool, dispatcher);
+    QFETCH(int, eventType);
+
+    QWidget widget;
+    std::vector<std::unique_ptr<StackedFilter>> filters;
+    for (int i = 0; i < helpers; ++i) {
+        const auto& types = watchedTypes[i % watchedTypes.size()];
+        if (dispatcher) {
+            EventTypeMask mask;
+            for (auto type : types) {
+                mask |= EventTypeMask { type };
+            }
+            WidgetEventDispatcher::of(&widget)->subscribe(&widget, mask, [](QWidget*, QEvent*) { return false; });
+        }
+        else {
+            filters.push_back(std::make_unique<StackedFilter>(types));
+            widget.installEventFilter(filters.back().get());
+        }
+    }
+
+    QPointF pos(10, 10);
+    QMouseEvent move(QEvent::MouseMove, pos, widget.mapToGlobal(pos), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    QEvent enter(QEvent::Enter);
+    QEvent* event = eventType == QEvent::MouseMove ? static_cast<QEvent*>(&move) : &enter;
+
+    QBENCHMARK {
+        QCoreApplication::sendEvent(&widget, event);
+    }
+}
+
+
+QTEST_MAIN(EventDispatchBenchmark)
+
+#include "EventDispatchBenchmark.moc"
@@ -0,0 +1,140 @@
+#include <QtTest>
+#include <QDBusConnection>
+#include <QDBusContext>
+#include <QDBusArgument>
+#include <QDBusVariant>
+
+#include "QFluentWidgets/utils/OS.hpp"
+
+using namespace fluent;
+
+static const char* FAKE_SERVICE = "org.qfluent.test.Portal";
+static const char* PORTAL_PATH = "/org/freedesktop/portal/desktop";
+static const char* APPEARANCE_NAMESPACE = "org.freedesktop.appearance";
+
+
+// Stand-in for the org.freedesktop.portal.Settings interface of
+// xdg-desktop-portal, serving the appearance namespace only
+class FakePortal : public QObject, protected QDBusContext
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.portal.Settings")
+
+public:
+    uint colorScheme = 1;
+    double accent[3] = { 0.0, 0.5, 1.0 };
+
+public slots:
+    QDBusVariant Read(const QString& ns, const QString& key) {
+        if (ns != APPEARANCE_NAMESPACE || (key != "color-scheme" && key != "accent-color")) {
+            sendErrorReply("org.freedesktop.portal.Error.NotFound", "Requested setting not found");
+            return QDBusVariant();
+        }
+
+        // Like the real portal, Read() wraps the value in one more variant
+        return QDBusVariant(QVariant::fromValue(QDBusVariant(value(key))));
+    }
+
+signals:
+    void SettingChanged(const QString& ns, const QString& key, const QDBusVariant& value);
+
+public:
+    QVariant value(const QString& key) const {
+        if (key == "color-scheme") {
+            return QVariant::fromValue(colorScheme);
+        }
+
+        QDBusArgument arg;
+        arg.beginStructure();
+        arg << accent[0] << accent[1] << accent[2];
+        arg.endStructure();
+        return QVariant::fromValue(arg);
+    }
+
+    void change(const QString& key) {
+        emit SettingChanged(APPEARANCE_NAMESPACE, key, QDBusVariant(value(key)));
+    }
+};
+
+
+class PortalSettingsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void readsInitialSettings();
+    void followsSettingChanged();
+    void resetsUnsetAccentColor();
+
+private:
+    FakePortal portal;
+    QDBusConnection bus = QDBusConnection(QString());
+};
+
+
+static int themeChanges = 0;
+
+static void onThemeChanged() {
+    ++themeChanges;
+}
+
+
+void PortalSettingsTest::initTestCase() {
+    // The fake lives on its own connection, the backend talks to it as it
+    // would to xdg-desktop-portal
+    bus = QDBusConnection::connectToBus(QDBusConnection::SessionBus, "fake-portal");
+    if (!bus.isConnected()) {
+        QSKIP("No D-Bus session bus, run the test under dbus-run-session");
+    }
+
+    QVERIFY(bus.registerObject(PORTAL_PATH, &portal, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllSignals));
+    QVERIFY(bus.registerService(FAKE_SERVICE));
+
+    // Read by the backend when it first starts
+    qputenv("QFLUENT_PORTAL_SERVICE", FAKE_SERVICE);
+    os::setThemeChangedCallback(&onThemeChanged);
+}
+
+
+void PortalSettingsTest::readsInitialSettings() {
+    QVERIFY(!os::isDarkTheme());
+    QTRY_VERIFY(os::isDarkTheme());
+
+    QTRY_COMPARE(qRound(os::getPrimaryColor().g * 255), 128);
+    os::v_color color = os::getPrimaryColor();
+    QCOMPARE(qRound(color.r * 255), 0);
+    QCOMPARE(qRound(color.b * 255), 255);
+    QCOMPARE(color.a, 1.0f);
+    QVERIFY(themeChanges > 0);
+}
+
+
+void PortalSettingsTest::followsSettingChanged() {
+    int changes = themeChanges;
+
+    portal.colorScheme = 2;
+    portal.change("color-scheme");
+    QTRY_VERIFY(!os::isDarkTheme());
+    QCOMPARE(themeChanges, changes + 1);
+
+    portal.colorScheme = 1;
+    portal.change("color-scheme");
+    QTRY_VERIFY(os::isDarkTheme());
+    QCOMPARE(themeChanges, changes + 2);
+}
+
+
+void PortalSettingsTest::resetsUnsetAccentColor() {
+    portal.accent[0] = portal.accent[1] = portal.accent[2] = -1;
+    portal.change("accent-color");
+
+    // Out of range channels fall back to the Fluent theme color #009faa
+    QTRY_COMPARE(qRound(os::getPrimaryColor().g * 255), 0x9f);
+    QCOMPARE(qRound(os::getPrimaryColor().b * 255), 0xaa);
+}
+
+
+QTEST_GUILESS_MAIN(PortalSettingsTest)
+
+#include "PortalSettingsTest.moc"
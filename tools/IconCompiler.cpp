@@ -0,0 +1,747 @@
+// Compiles the Fluent svg icons into the icon registry and path data.
+//
+//     IconCompiler <icon directory> <alias file> <qrc file> <output directory>
+//
+// Every <name>_black.svg / <name>_white.svg pair becomes one icon, a file
+// without its pair or a pair missing from the qrc is an error. Two headers
+// are written to the output directory:
+//
+//  - FluentIconTypes.hpp: the X-macro lists FluentIcon::IconType is built
+//    from, in name order, plus the aliases from the alias file;
+//  - VectorIconData.hpp: the paths of every icon in the same order,
+//    flattened into absolute move/line/quad/cubic/close commands with
+//    element and group transforms applied, and the coordinates mapped from
+//    the viewBox to int16 in [0, unit]. The colors are dropped, they are
+//    applied as the brush at runtime.
+//
+// Only the standard library is used so the tool builds before Qt is involved.
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr int unit = 4096;
+    constexpr double pi = 3.14159265358979323846;
+
+    enum Command : std::uint8_t {
+        MoveTo,
+        LineTo,
+        QuadTo,
+        CubicTo,
+        Close
+    };
+
+
+    struct Point {
+        double x = 0;
+        double y = 0;
+    };
+
+
+    // Affine matrix as in svg: (a c e / b d f)
+    struct Matrix {
+        double a = 1, b = 0, c = 0, d = 1, e = 0, f = 0;
+
+        Matrix operator*(const Matrix& m) const {
+            return {
+                a * m.a + c * m.b,
+                b * m.a + d * m.b,
+                a * m.c + c * m.d,
+                b * m.c + d * m.d,
+                a * m.e + c * m.f + e,
+                b * m.e + d * m.f + f
+            };
+        }
+
+        Point map(const Point& p) const {
+            return { a * p.x + c * p.y + e, b * p.x + d * p.y + f };
+        }
+    };
+
+
+    struct Icon {
+        std::string name;
+        std::vector<std::uint8_t> commands;
+        std::vector<std::int16_t> coords;
+        bool evenOdd = false;
+    };
+
+
+    [[noreturn]] void fail(const std::string& file, const std::string& message) {
+        throw std::runtime_error(file + ": " + message);
+    }
+
+
+    std::string readFile(const fs::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+
+    // Minimal number list reader shared by path data, transforms and viewBox
+    class Scanner {
+    public:
+        explicit Scanner(const std::string& text) : text(text) {}
+
+        void skipSeparators() {
+            while (pos < text.size() && (std::isspace(static_cast<unsigned char>(text[pos])) || text[pos] == ',')) {
+                ++pos;
+            }
+        }
+
+        bool atEnd() {
+            skipSeparators();
+            return pos >= text.size();
+        }
+
+        bool atNumber() {
+            skipSeparators();
+            if (pos >= text.size()) {
+                return false;
+            }
+            char ch = text[pos];
+            return std::isdigit(static_cast<unsigned char>(ch)) || ch == '-' || ch == '+' || ch == '.';
+        }
+
+        char peek() {
+            skipSeparators();
+            return pos < text.size() ? text[pos] : '\0';
+        }
+
+        char take() {
+            skipSeparators();
+            return text[pos++];
+        }
+
+        double number() {
+            skipSeparators();
+            const char* begin = text.c_str() + pos;
+            char* end = nullptr;
+            double value = std::strtod(begin, &end);
+            if (end == begin) {
+                throw std::runtime_error("expected a number at '" + text.substr(pos, 16) + "'");
+            }
+            pos += end - begin;
+            return value;
+        }
+
+        // Arc flags may be written without separators, e.g. "a1 1 0 011 1"
+        bool flag() {
+            skipSeparators();
+            if (pos >= text.size() || (text[pos] != '0' && text[pos] != '1')) {
+                throw std::runtime_error("expected an arc flag");
+            }
+            return text[pos++] == '1';
+        }
+
+    private:
+        const std::string& text;
+        size_t pos = 0;
+    };
+
+
+    std::map<std::string, std::string> parseAttributes(const std::string& tag) {
+        std::map<std::string, std::string> attributes;
+        size_t pos = 0;
+        while (pos < tag.size()) {
+            size_t eq = tag.find('=', pos);
+            if (eq == std::string::npos) {
+                break;
+            }
+
+            size_t nameEnd = eq;
+            while (nameEnd > pos && std::isspace(static_cast<unsigned char>(tag[nameEnd - 1]))) {
+                --nameEnd;
+            }
+            size_t nameBegin = nameEnd;
+            while (nameBegin > pos && !std::isspace(static_cast<unsigned char>(tag[nameBegin - 1]))) {
+                --nameBegin;
+            }
+
+            size_t quote = tag.find_first_of("\"'", eq);
+            if (quote == std::string::npos) {
+                break;
+            }
+            size_t close = tag.find(tag[quote], quote + 1);
+            if (close == std::string::npos) {
+                break;
+            }
+
+            attributes[tag.substr(nameBegin, nameEnd - nameBegin)] = tag.substr(quote + 1, close - quote - 1);
+            pos = close + 1;
+        }
+        return attributes;
+    }
+
+
+    Matrix parseTransform(const std::string& text) {
+        Matrix result;
+        size_t pos = 0;
+        while (true) {
+            size_t open = text.find('(', pos);
+            if (open == std::string::npos) {
+                break;
+            }
+            size_t close = text.find(')', open);
+            if (close == std::string::npos) {
+                throw std::runtime_error("unterminated transform");
+            }
+
+            std::string name = text.substr(pos, open - pos);
+            name.erase(std::remove_if(name.begin(), name.end(), [](char ch) { return std::isspace(static_cast<unsigned char>(ch)) || ch == ','; }), name.end());
+
+            std::string argumentText = text.substr(open + 1, close - open - 1);
+            Scanner scanner(argumentText);
+            std::vector<double> args;
+            while (!scanner.atEnd()) {
+                args.push_back(scanner.number());
+            }
+
+            Matrix m;
+            if (name == "translate" && !args.empty()) {
+                m.e = args[0];
+                m.f = args.size() > 1 ? args[1] : 0;
+            }
+            else if (name == "scale" && !args.empty()) {
+                m.a = args[0];
+                m.d = args.size() > 1 ? args[1] : args[0];
+            }
+            else if (name == "rotate" && !args.empty()) {
+                double angle = args[0] * pi / 180;
+                Matrix rotation{ std::cos(angle), std::sin(angle), -std::sin(angle), std::cos(angle), 0, 0 };
+                if (args.size() >= 3) {
+                    Matrix to{ 1, 0, 0, 1, args[1], args[2] };
+                    Matrix back{ 1, 0, 0, 1, -args[1], -args[2] };
+                    m = to * rotation * back;
+                }
+                else {
+                    m = rotation;
+                }
+            }
+            else if (name == "matrix" && args.size() == 6) {
+                m = { args[0], args[1], args[2], args[3], args[4], args[5] };
+            }
+            else {
+                throw std::runtime_error("unsupported transform '" + name + "'");
+            }
+
+            result = result * m;
+            pos = close + 1;
+        }
+        return result;
+    }
+
+
+    class PathBuilder {
+    public:
+        PathBuilder(Icon& icon, const Matrix& toUnit) : icon(icon), toUnit(toUnit) {}
+
+        void command(Command command, std::initializer_list<Point> points) {
+            icon.commands.push_back(command);
+            for (const Point& point : points) {
+                Point mapped = toUnit.map(point);
+                icon.coords.push_back(quantize(mapped.x));
+                icon.coords.push_back(quantize(mapped.y));
+            }
+        }
+
+    private:
+        Icon& icon;
+        Matrix toUnit;
+
+        static std::int16_t quantize(double value) {
+            long rounded = std::lround(value);
+            if (rounded < INT16_MIN || rounded > INT16_MAX) {
+                throw std::runtime_error("coordinate out of range");
+            }
+            return static_cast<std::int16_t>(rounded);
+        }
+    };
+
+
+    // Endpoint to center parameterization from the svg spec, then one cubic
+    // per quarter turn at most
+    void arcTo(PathBuilder& out, Point from, double rx, double ry, double rotation, bool large, bool sweep, Point to) {
+        if (from.x == to.x && from.y == to.y) {
+            return;
+        }
+        rx = std::fabs(rx);
+        ry = std::fabs(ry);
+        if (rx == 0 || ry == 0) {
+            out.command(LineTo, { to });
+            return;
+        }
+
+        double phi = rotation * pi / 180;
+        double cosPhi = std::cos(phi);
+        double sinPhi = std::sin(phi);
+
+        double dx = (from.x - to.x) / 2;
+        double dy = (from.y - to.y) / 2;
+        double x1 = cosPhi * dx + sinPhi * dy;
+        double y1 = -sinPhi * dx + cosPhi * dy;
+
+        double lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+        if (lambda > 1) {
+            rx *= std::sqrt(lambda);
+            ry *= std::sqrt(lambda);
+        }
+
+        double numerator = rx * rx * ry * ry - rx * rx * y1 * y1 - ry * ry * x1 * x1;
+        double denominator = rx * rx * y1 * y1 + ry * ry * x1 * x1;
+        double factor = std::sqrt(std::max(0.0, numerator / denominator)) * (large == sweep ? -1 : 1);
+        double cx1 = factor * rx * y1 / ry;
+        double cy1 = -factor * ry * x1 / rx;
+
+        double cx = cosPhi * cx1 - sinPhi * cy1 + (from.x + to.x) / 2;
+        double cy = sinPhi * cx1 + cosPhi * cy1 + (from.y + to.y) / 2;
+
+        auto angle = [](double ux, double uy, double vx, double vy) {
+            return std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+        };
+
+        double start = angle(1, 0, (x1 - cx1) / rx, (y1 - cy1) / ry);
+        double delta = angle((x1 - cx1) / rx, (y1 - cy1) / ry, (-x1 - cx1) / rx, (-y1 - cy1) / ry);
+        if (!sweep && delta > 0) {
+            delta -= 2 * pi;
+        }
+        else if (sweep && delta < 0) {
+            delta += 2 * pi;
+        }
+
+        int segments = static_cast<int>(std::ceil(std::fabs(delta) / (pi / 2)));
+        double step = delta / segments;
+        double k = 4.0 / 3.0 * std::tan(step / 4);
+
+        auto point = [&](double t, double scale, double offset) {
+            double x = rx * (std::cos(t) - scale * std::sin(t) * offset);
+            double y = ry * (std::sin(t) + scale * std::cos(t) * offset);
+            return Point{ cosPhi * x - sinPhi * y + cx, sinPhi * x + cosPhi * y + cy };
+        };
+
+        double t = start;
+        for (int i = 0; i < segments; ++i) {
+            double next = t + step;
+            Point c1 = point(t, k, 1);
+            Point c2 = point(next, k, -1);
+            Point end = i == segments - 1 ? to : point(next, 0, 0);
+            out.command(CubicTo, { c1, c2, end });
+            t = next;
+        }
+    }
+
+
+    void compilePath(const std::string& data, PathBuilder& out) {
+        Scanner in(data);
+        Point current;
+        Point start;
+        Point lastControl;
+        char lastCommand = 0;
+        char command = 0;
+
+        while (!in.atEnd()) {
+            if (std::isalpha(static_cast<unsigned char>(in.peek()))) {
+                command = in.take();
+            }
+            else if (command == 0) {
+                throw std::runtime_error("path data must start with a command");
+            }
+
+            bool relative = std::islower(static_cast<unsigned char>(command));
+            Point base = relative ? current : Point{};
+            auto readPoint = [&] {
+                double x = in.number();
+                double y = in.number();
+                return Point{ base.x + x, base.y + y };
+            };
+
+            switch (std::toupper(static_cast<unsigned char>(command))) {
+            case 'M':
+                current = start = readPoint();
+                out.command(MoveTo, { current });
+                // Further pairs after a moveto are implicit linetos
+                command = relative ? 'l' : 'L';
+                break;
+            case 'L':
+                current = readPoint();
+                out.command(LineTo, { current });
+                break;
+            case 'H':
+                current.x = (relative ? current.x : 0) + in.number();
+                out.command(LineTo, { current });
+                break;
+            case 'V':
+                current.y = (relative ? current.y : 0) + in.number();
+                out.command(LineTo, { current });
+                break;
+            case 'C': {
+                Point c1 = readPoint();
+                Point c2 = readPoint();
+                current = readPoint();
+                out.command(CubicTo, { c1, c2, current });
+                lastControl = c2;
+                break;
+            }
+            case 'S': {
+                bool smooth = lastCommand == 'C' || lastCommand == 'S';
+                Point c1 = smooth ? Point{ 2 * current.x - lastControl.x, 2 * current.y - lastControl.y } : current;
+                Point c2 = readPoint();
+                current = readPoint();
+                out.command(CubicTo, { c1, c2, current });
+                lastControl = c2;
+                break;
+            }
+            case 'Q': {
+                Point c = readPoint();
+                current = readPoint();
+                out.command(QuadTo, { c, current });
+                lastControl = c;
+                break;
+            }
+            case 'T': {
+                bool smooth = lastCommand == 'Q' || lastCommand == 'T';
+                Point c = smooth ? Point{ 2 * current.x - lastControl.x, 2 * current.y - lastControl.y } : current;
+                current = readPoint();
+                out.command(QuadTo, { c, current });
+                lastControl = c;
+                break;
+            }
+            case 'A': {
+                double rx = in.number();
+                double ry = in.number();
+                double rotation = in.number();
+                bool large = in.flag();
+                bool sweep = in.flag();
+                Point to = readPoint();
+                arcTo(out, current, rx, ry, rotation, large, sweep, to);
+                current = to;
+                break;
+            }
+            case 'Z':
+                out.command(Close, {});
+                current = start;
+                break;
+            default:
+                throw std::runtime_error(std::string("unsupported path command '") + command + "'");
+            }
+
+            lastCommand = static_cast<char>(std::toupper(static_cast<unsigned char>(command)));
+            if (lastCommand == 'Z') {
+                // "z" takes no arguments, a following number is an error
+                if (in.atNumber()) {
+                    throw std::runtime_error("numbers after closepath");
+                }
+            }
+        }
+    }
+
+
+    Icon compileIcon(const fs::path& file, const std::string& name) {
+        std::string text = readFile(file);
+        Icon icon;
+        icon.name = name;
+
+        size_t svgOpen = text.find("<svg");
+        if (svgOpen == std::string::npos) {
+            fail(file.string(), "no <svg> element");
+        }
+        auto svg = parseAttributes(text.substr(svgOpen + 4, text.find('>', svgOpen) - svgOpen - 4));
+
+        double vx = 0, vy = 0, vw = 0, vh = 0;
+        if (svg.count("viewBox")) {
+            Scanner box(svg["viewBox"]);
+            vx = box.number();
+            vy = box.number();
+            vw = box.number();
+            vh = box.number();
+        }
+        else {
+            vw = std::atof(svg["width"].c_str());
+            vh = std::atof(svg["height"].c_str());
+        }
+        if (vw <= 0 || vh <= 0) {
+            fail(file.string(), "no usable viewBox or size");
+        }
+
+        // Like QSvgRenderer::render, the viewBox is stretched to the target
+        Matrix toUnit{ unit / vw, 0, 0, unit / vh, -vx * unit / vw, -vy * unit / vh };
+
+        std::vector<Matrix> groups{ Matrix() };
+        size_t pos = svgOpen;
+        while ((pos = text.find('<', pos + 1)) != std::string::npos) {
+            size_t end = text.find('>', pos);
+            if (end == std::string::npos) {
+                fail(file.string(), "unterminated tag");
+            }
+            std::string tag = text.substr(pos + 1, end - pos - 1);
+            bool selfClosing = !tag.empty() && tag.back() == '/';
+
+            if (tag.compare(0, 2, "/g") == 0) {
+                if (groups.size() > 1) {
+                    groups.pop_back();
+                }
+            }
+            else if (tag.compare(0, 1, "g") == 0 && (tag.size() == 1 || std::isspace(static_cast<unsigned char>(tag[1])) || tag[1] == '/')) {
+                auto attributes = parseAttributes(tag.substr(1));
+                Matrix m = groups.back();
+                if (attributes.count("transform")) {
+                    m = m * parseTransform(attributes["transform"]);
+                }
+                if (!selfClosing) {
+                    groups.push_back(m);
+                }
+            }
+            else if (tag.compare(0, 4, "path") == 0) {
+                auto attributes = parseAttributes(tag.substr(4));
+                Matrix m = groups.back();
+                if (attributes.count("transform")) {
+                    m = m * parseTransform(attributes["transform"]);
+                }
+                if (attributes["fill-rule"] == "evenodd") {
+                    icon.evenOdd = true;
+                }
+
+                PathBuilder builder(icon, toUnit * m);
+                try {
+                    compilePath(attributes["d"], builder);
+                }
+                catch (const std::exception& error) {
+                    fail(file.string(), error.what());
+                }
+            }
+            else if (tag.compare(0, 6, "circle") == 0 || tag.compare(0, 4, "rect") == 0
+                || tag.compare(0, 7, "polygon") == 0 || tag.compare(0, 7, "ellipse") == 0) {
+                fail(file.string(), "only <path> shapes are supported");
+            }
+            pos = end;
+        }
+
+        if (icon.commands.empty()) {
+            fail(file.string(), "no path data");
+        }
+        return icon;
+    }
+
+
+    bool endsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+
+    bool isIdentifier(const std::string& name) {
+        if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+            return false;
+        }
+        return std::all_of(name.begin(), name.end(), [](char ch) { return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_'; });
+    }
+
+
+    // "Alias Icon" per line, # starts a comment
+    std::vector<std::pair<std::string, std::string>> readAliases(const fs::path& file, const std::map<std::string, fs::path>& icons) {
+        std::vector<std::pair<std::string, std::string>> aliases;
+        std::istringstream lines(readFile(file));
+        std::string line;
+        int number = 0;
+        while (std::getline(lines, line)) {
+            ++number;
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream words(line);
+            std::string alias, target, extra;
+            if (!(words >> alias)) {
+                continue;
+            }
+            if (!(words >> target) || (words >> extra)) {
+                fail(file.string() + ":" + std::to_string(number), "expected 'Alias Icon'");
+            }
+            if (!isIdentifier(alias) || icons.count(alias)) {
+                fail(file.string() + ":" + std::to_string(number), "'" + alias + "' is not a free icon name");
+            }
+            if (!icons.count(target)) {
+                fail(file.string() + ":" + std::to_string(number), "no icon named '" + target + "'");
+            }
+            aliases.emplace_back(alias, target);
+        }
+        return aliases;
+    }
+
+
+    void writeIfChanged(const fs::path& output, const std::string& text) {
+        // Leave an unchanged header alone so dependents don't rebuild
+        if (fs::exists(output) && readFile(output) == text) {
+            return;
+        }
+        fs::create_directories(output.parent_path());
+        std::ofstream(output, std::ios::binary) << text;
+    }
+
+
+    void writeIconTypes(const fs::path& output, const std::vector<Icon>& icons, const std::vector<std::pair<std::string, std::string>>& aliases) {
+        std::ostringstream out;
+        out << "// Generated by tools/IconCompiler.cpp from src/assets/images/icons, do not edit\n"
+            << "#pragma once\n\n"
+            << "// X(name) for every icon, in the order of fluent::icondata::entries\n"
+            << "#define QFLUENT_ICON_TYPES(X)";
+        for (const Icon& icon : icons) {
+            out << " \\\n    X(" << icon.name << ")";
+        }
+
+        out << "\n\n// X(alias, name) for the names listed in tools/IconAliases.txt\n"
+            << "#define QFLUENT_ICON_ALIASES(X)";
+        for (const auto& [alias, target] : aliases) {
+            out << " \\\n    X(" << alias << ", " << target << ")";
+        }
+
+        out << "\n\nnamespace fluent::icondata {\n\n"
+            << "    constexpr int iconCount = " << icons.size() << ";\n\n"
+            << "    constexpr const char* iconNames[] = {";
+        for (size_t i = 0; i < icons.size(); ++i) {
+            out << (i % 8 == 0 ? "\n        " : " ") << '"' << icons[i].name << "\",";
+        }
+        out << "\n    };\n\n"
+            << "}\n";
+
+        writeIfChanged(output, out.str());
+    }
+
+
+    void writeVectorData(const fs::path& output, const std::vector<Icon>& icons) {
+        std::ostringstream out;
+        out << "// Generated by tools/IconCompiler.cpp from src/assets/images/icons, do not edit\n"
+            << "#pragma once\n\n"
+            << "#include <cstdint>\n\n"
+            << "namespace fluent::icondata {\n\n"
+            << "    enum Command : std::uint8_t { MoveTo, LineTo, QuadTo, CubicTo, Close };\n\n"
+            << "    // Coordinates span [0, unit] over the icon's viewBox\n"
+            << "    constexpr int unit = " << unit << ";\n\n"
+            << "    struct Entry {\n"
+            << "        const char* name;\n"
+            << "        std::uint32_t firstCommand;\n"
+            << "        std::uint32_t commandCount;\n"
+            << "        std::uint32_t firstCoord;\n"
+            << "        bool evenOdd;\n"
+            << "    };\n\n";
+
+        out << "    constexpr std::uint8_t commands[] = {";
+        size_t column = 0;
+        for (const Icon& icon : icons) {
+            for (std::uint8_t command : icon.commands) {
+                out << (column++ % 40 == 0 ? "\n        " : "") << int(command) << ',';
+            }
+        }
+        out << "\n    };\n\n";
+
+        out << "    constexpr std::int16_t coords[] = {";
+        column = 0;
+        for (const Icon& icon : icons) {
+            for (std::int16_t coord : icon.coords) {
+                out << (column++ % 20 == 0 ? "\n        " : "") << coord << ',';
+            }
+        }
+        out << "\n    };\n\n";
+
+        // Sorted by name, looked up with a binary search
+        out << "    constexpr Entry entries[] = {\n";
+        size_t firstCommand = 0;
+        size_t firstCoord = 0;
+        for (const Icon& icon : icons) {
+            out << "        { \"" << icon.name << "\", " << firstCommand << ", " << icon.commands.size() << ", "
+                << firstCoord << ", " << (icon.evenOdd ? "true" : "false") << " },\n";
+            firstCommand += icon.commands.size();
+            firstCoord += icon.coords.size();
+        }
+        out << "    };\n\n"
+            << "    constexpr int count = " << icons.size() << ";\n\n"
+            << "}\n";
+
+        writeIfChanged(output, out.str());
+    }
+
+}
+
+
+int main(int argc, char** argv) {
+    if (argc != 5) {
+        std::cerr << "usage: IconCompiler <icon directory> <alias file> <qrc file> <output directory>\n";
+        return 2;
+    }
+
+    try {
+        std::map<std::string, fs::path> black;
+        std::map<std::string, fs::path> white;
+        for (const auto& entry : fs::directory_iterator(argv[1])) {
+            std::string stem = entry.path().stem().string();
+            if (entry.path().extension() != ".svg") {
+                continue;
+            }
+            if (!endsWith(stem, "_black") && !endsWith(stem, "_white")) {
+                std::cerr << "IconCompiler: ignoring " << entry.path().filename().string() << "\n";
+                continue;
+            }
+
+            std::string name = stem.substr(0, stem.size() - 6);
+            if (!isIdentifier(name)) {
+                fail(entry.path().string(), "'" + name + "' is not a valid icon name");
+            }
+            (endsWith(stem, "_black") ? black : white)[name] = entry.path();
+        }
+
+        for (const auto& [name, file] : black) {
+            if (!white.count(name)) {
+                fail(file.string(), "missing " + name + "_white.svg");
+            }
+        }
+        for (const auto& [name, file] : white) {
+            if (!black.count(name)) {
+                fail(file.string(), "missing " + name + "_black.svg");
+            }
+        }
+
+        // The icons are loaded from the resources at runtime
+        std::string qrc = readFile(argv[3]);
+        for (const auto& [name, file] : black) {
+            for (const char* color : { "black", "white" }) {
+                std::string resource = "images/icons/" + name + "_" + color + ".svg";
+                if (qrc.find(">" + resource + "<") == std::string::npos) {
+                    fail(argv[3], "missing <file>" + resource + "</file>");
+                }
+            }
+        }
+
+        // Both variants are one vector icon, only the color differs
+        std::vector<Icon> icons;
+        for (const auto& [name, file] : black) {
+            icons.push_back(compileIcon(file, name));
+            Icon other = compileIcon(white[name], name);
+            if (other.commands != icons.back().commands || other.coords != icons.back().coords) {
+                std::cerr << "IconCompiler: warning: " << name << "_black.svg and " << name
+                    << "_white.svg differ, using the black one\n";
+            }
+        }
+
+        fs::path output(argv[4]);
+        writeIconTypes(output / "FluentIconTypes.hpp", icons, readAliases(argv[2], black));
+        writeVectorData(output / "VectorIconData.hpp", icons);
+    }
+    catch (const std::exception& error) {
+        std::cerr << "IconCompiler: " << error.what() << "\n";
+        return 1;
+    }
+    return 0;
+}